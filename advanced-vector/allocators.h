@@ -0,0 +1,467 @@
+#pragma once
+
+#include "vector.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Аллокатор крупных буферов поверх mmap с включением прозрачных huge pages (THP).
+// Блоки от ThresholdBytes и больше отображаются напрямую через mmap и помечаются
+// MADV_HUGEPAGE - меньше промахов dTLB на многогигабайтных векторах; блоки меньше
+// порога обслуживаются обычным operator new. Расширение mmap-блока выполняется
+// на месте через mremap без MREMAP_MAYMOVE, что включает путь RawMemory::TryExtend.
+// Вне Linux аллокатор прозрачно сводится к operator new/delete
+template <typename T, size_t ThresholdBytes = (size_t{ 2 } << 20)>
+struct HugePageAllocator {
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, ThresholdBytes>;
+    };
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, ThresholdBytes>&) noexcept {
+    }
+
+    // Сообщает, обслуживается ли блок из n элементов через mmap
+    static bool IsMapped(size_t n) noexcept {
+        return n * sizeof(T) >= ThresholdBytes;
+    }
+
+    T* allocate(size_t n) {
+#ifdef __linux__
+        if (IsMapped(n)) {
+            const size_t bytes = RoundUpToPage(n * sizeof(T));
+            void* block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (block == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(block, bytes, MADV_HUGEPAGE);
+#endif
+            return static_cast<T*>(block);
+        }
+#endif
+        return static_cast<T*>(operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+#ifdef __linux__
+        // способ возврата определяется тем же порогом, что и способ выделения
+        if (IsMapped(n)) {
+            munmap(buf, RoundUpToPage(n * sizeof(T)));
+            return;
+        }
+#endif
+        operator delete(buf);
+    }
+
+    // Расширяет mmap-блок на месте; перенос буфера запрещён (без MREMAP_MAYMOVE)
+    bool TryResize(T* buf, size_t old_n, size_t new_n) noexcept {
+#ifdef __linux__
+        if (IsMapped(old_n) && IsMapped(new_n)) {
+            const size_t old_bytes = RoundUpToPage(old_n * sizeof(T));
+            const size_t new_bytes = RoundUpToPage(new_n * sizeof(T));
+            if (new_bytes == old_bytes) {
+                return true;
+            }
+            return mremap(buf, old_bytes, new_bytes, 0) != MAP_FAILED;
+        }
+#else
+        (void)buf;
+        (void)old_n;
+        (void)new_n;
+#endif
+        return false;
+    }
+
+private:
+#ifdef __linux__
+    // Округляет размер блока вверх до границы страницы
+    static size_t RoundUpToPage(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+#endif
+};
+
+template <typename T, typename U, size_t Threshold>
+bool operator==(const HugePageAllocator<T, Threshold>&, const HugePageAllocator<U, Threshold>&) noexcept {
+    return true;
+}
+template <typename T, typename U, size_t Threshold>
+bool operator!=(const HugePageAllocator<T, Threshold>&, const HugePageAllocator<U, Threshold>&) noexcept {
+    return false;
+}
+
+// Вектор для многогигабайтных данных: крупные буферы на huge pages
+template <typename T>
+using HugePageVector = Vector<T, HugePageAllocator<T>>;
+
+// Пул переиспользуемых буферов для короткоживущих векторов: deallocate не возвращает
+// блок в кучу, а кладёт его в thread-local список своего класса ёмкости, allocate
+// сначала разбирает эти списки. Конвейер, создающий и разрушающий вектор на каждое
+// сообщение, на установившемся режиме не обращается к куче вовсе и работает по уже
+// прогретым страницам. Размеры округляются вверх до степени двойки, поэтому блоки
+// переиспользуются и между запросами немного разной ёмкости; каждый класс удерживает
+// не более kMaxBlocksPerClass блоков, излишек уходит обратно в кучу. Блок, освобождённый
+// в чужом потоке, безопасно переселяется в пул этого потока
+template <typename T>
+struct PooledAllocator {
+
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+        "PooledAllocator does not support over-aligned element types");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = PooledAllocator<U>;
+    };
+
+    PooledAllocator() = default;
+    template <typename U>
+    PooledAllocator(const PooledAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t cls = ClassIndex(n * sizeof(T));
+        if (cls < Pool::kClasses) {
+            Pool& pool = LocalPool();
+            if (pool.free_lists[cls] != nullptr) {
+                FreeBlock* block = pool.free_lists[cls];
+                pool.free_lists[cls] = block->next;
+                --pool.counts[cls];
+                return reinterpret_cast<T*>(block);
+            }
+            return static_cast<T*>(operator new(ClassBytes(cls)));
+        }
+        return static_cast<T*>(operator new(n * sizeof(T)));      // крупнее крайнего класса - мимо пула
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        const size_t cls = ClassIndex(n * sizeof(T));
+        if (cls < Pool::kClasses) {
+            Pool& pool = LocalPool();
+            if (pool.counts[cls] < Pool::kMaxBlocksPerClass) {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(buf);
+                block->next = pool.free_lists[cls];
+                pool.free_lists[cls] = block;
+                ++pool.counts[cls];
+                return;
+            }
+        }
+        operator delete(buf);
+    }
+
+    // Количество блоков, удержанных пулом текущего потока
+    static size_t LocalPoolBlocks() noexcept {
+        const Pool& pool = LocalPool();
+        size_t total = 0;
+        for (size_t cls = 0; cls < Pool::kClasses; ++cls) {
+            total += pool.counts[cls];
+        }
+        return total;
+    }
+
+    // Возвращает в кучу все блоки, удержанные пулом текущего потока
+    static void TrimLocalPool() noexcept {
+        LocalPool().Trim();
+    }
+
+private:
+    // Свободный блок хранит указатель на следующий прямо в собственной памяти -
+    // минимальный класс ёмкости гарантирует место под указатель
+    struct FreeBlock {
+        FreeBlock* next = nullptr;
+    };
+
+    struct Pool {
+        static constexpr size_t kClasses = 32;                    // классы от 64 байт до 64 * 2^31
+        static constexpr size_t kMaxBlocksPerClass = 8;           // граница памяти, удержанной классом
+
+        FreeBlock* free_lists[kClasses] = {};
+        size_t counts[kClasses] = {};
+
+        void Trim() noexcept {
+            for (size_t cls = 0; cls < kClasses; ++cls) {
+                while (free_lists[cls] != nullptr) {
+                    FreeBlock* block = free_lists[cls];
+                    free_lists[cls] = block->next;
+                    operator delete(block);
+                }
+                counts[cls] = 0;
+            }
+        }
+
+        ~Pool() {
+            Trim();                                               // смерть потока возвращает удержанное в кучу
+        }
+    };
+
+    static constexpr size_t kMinClassBytes = 64;
+
+    static Pool& LocalPool() noexcept {
+        thread_local Pool pool;
+        return pool;
+    }
+
+    // Индекс класса ёмкости - наименьшая степень двойки от kMinClassBytes, вмещающая bytes.
+    // Для блоков крупнее крайнего класса возвращает kClasses
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t cls = 0;
+        while (cls < Pool::kClasses && ClassBytes(cls) < bytes) {
+            ++cls;
+        }
+        return cls;
+    }
+    static constexpr size_t ClassBytes(size_t cls) noexcept {
+        return kMinClassBytes << cls;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PooledAllocator<T>&, const PooledAllocator<U>&) noexcept {
+    return true;
+}
+template <typename T, typename U>
+bool operator!=(const PooledAllocator<T>&, const PooledAllocator<U>&) noexcept {
+    return false;
+}
+
+// Вектор для конвейеров с коротким жизненным циклом: буферы ходят через пул потока
+template <typename T>
+using PooledVector = Vector<T, PooledAllocator<T>>;
+
+#ifdef __linux__
+
+// Аллокатор поверх открытого файла: буфер является MAP_SHARED-отображением файла,
+// элементы живут сразу на диске и подгружаются операционной системой по мере обращения.
+// Файл расширяется через ftruncate до точного размера запрошенного блока, рост буфера
+// выполняется на месте через mremap (путь RawMemory::TryExtend). Дескриптором файла
+// владеет вызывающий код - аллокатор его не открывает и не закрывает
+template <typename T>
+struct FileBackedAllocator {
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = FileBackedAllocator<U>;
+    };
+
+    FileBackedAllocator() = default;
+    explicit FileBackedAllocator(int fd) noexcept
+        : fd(fd) {
+    }
+    template <typename U>
+    FileBackedAllocator(const FileBackedAllocator<U>& other) noexcept
+        : fd(other.fd) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+
+        // файл должен вмещать все n элементов - усекаем его до точного размера блока
+        if (FileSize() < bytes && ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::bad_alloc();
+        }
+
+        void* block = mmap(nullptr, RoundUpToPage(bytes), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+        if (block == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(block);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        // отображение снимается, сам файл остаётся на диске
+        munmap(buf, RoundUpToPage(n * sizeof(T)));
+    }
+
+    // Расширяет файл и отображение на месте; перенос буфера запрещён (без MREMAP_MAYMOVE)
+    bool TryResize(T* buf, size_t old_n, size_t new_n) noexcept {
+        if (ftruncate(fd, static_cast<off_t>(new_n * sizeof(T))) != 0) {
+            return false;
+        }
+
+        const size_t old_bytes = RoundUpToPage(old_n * sizeof(T));
+        const size_t new_bytes = RoundUpToPage(new_n * sizeof(T));
+        if (new_bytes == old_bytes) {
+            return true;
+        }
+        return mremap(buf, old_bytes, new_bytes, 0) != MAP_FAILED;
+    }
+
+    // Текущий размер файла в байтах
+    size_t FileSize() const noexcept {
+        struct stat st {};
+        return fstat(fd, &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+    }
+
+    int fd = -1;
+
+private:
+    // Округляет размер блока вверх до границы страницы
+    static size_t RoundUpToPage(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const FileBackedAllocator<T>& lhs, const FileBackedAllocator<U>& rhs) noexcept {
+    return lhs.fd == rhs.fd;
+}
+template <typename T, typename U>
+bool operator!=(const FileBackedAllocator<T>& lhs, const FileBackedAllocator<U>& rhs) noexcept {
+    return lhs.fd != rhs.fd;
+}
+
+// Вектор, живущий в отображённом файле: данные больше оперативной памяти
+// подкачиваются операционной системой по мере обращения
+template <typename T>
+using FileBackedVector = Vector<T, FileBackedAllocator<T>>;
+
+// Строит вектор поверх существующего файла с ранее сохранённым массивом - без чтения
+// и копирования элементов: содержимое подгружается страницами при первом обращении.
+// Файл должен содержать ровно сохранённый массив (см. FlushToDisk)
+template <typename T>
+FileBackedVector<T> MapFileVector(int fd) {
+
+    static_assert(std::is_trivially_copyable_v<T>,
+        "File-backed load requires a trivially copyable element type");
+
+    FileBackedAllocator<T> alloc(fd);
+    const size_t count = alloc.FileSize() / sizeof(T);
+
+    T* buffer = count != 0 ? alloc.allocate(count) : nullptr;
+    return FileBackedVector<T>::Adopt(buffer, count, count, alloc);
+}
+
+// Сбрасывает содержимое файлового вектора на диск и усекает файл до логического
+// размера, чтобы MapFileVector восстановил ровно Size() элементов. После вызова
+// вектор следует использовать только для чтения либо сперва нарастить ёмкость
+template <typename T>
+bool FlushToDisk(FileBackedVector<T>& v) noexcept {
+    const size_t bytes = v.Size() * sizeof(T);
+    const FileBackedAllocator<T>& alloc = v.Data().GetAllocator();
+
+    if (bytes != 0 && msync(static_cast<void*>(v.begin()), bytes, MS_SYNC) != 0) {
+        return false;
+    }
+    return ftruncate(alloc.fd, static_cast<off_t>(bytes)) == 0;
+}
+
+// Политика размещения страниц буфера по NUMA-узлам
+enum class NumaPlacement {
+    kFirstTouch,        // страницы достаются узлу первого коснувшегося потока (политика ядра по умолчанию)
+    kInterleave,        // страницы чередуются по всем доступным узлам - суммарная полоса пропускания
+    kBindNode,          // все страницы закрепляются за заданным узлом - локальное чтение с него
+};
+
+// Аллокатор с управлением NUMA-размещением: буфер отображается напрямую через mmap,
+// страницы привязываются к узлам через mbind до первого касания. Размещение - подсказка
+// ядру: на одноузловых машинах и ядрах без NUMA вызовы вырождаются в no-op. Политика
+// kFirstTouch не зовёт mbind вовсе - страницы раскладывает параллельная инициализация
+// (Resize/Reserve с thread_count), касающаяся буфера из потоков на разных узлах.
+// Номера MPOL_* взяты из linux/mempolicy.h, чтобы не тянуть зависимость от libnuma
+template <typename T>
+struct NumaAllocator {
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = NumaAllocator<U>;
+    };
+
+    NumaAllocator() = default;
+    explicit NumaAllocator(NumaPlacement placement, unsigned node = 0) noexcept
+        : placement(placement)
+        , node(node) {
+    }
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept
+        : placement(other.placement)
+        , node(other.node) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = RoundUpToPage(n * sizeof(T));
+        void* block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        ApplyPlacement(block, bytes);
+        return static_cast<T*>(block);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        munmap(buf, RoundUpToPage(n * sizeof(T)));
+    }
+
+    NumaPlacement placement = NumaPlacement::kFirstTouch;
+    unsigned node = 0;
+
+private:
+    // Привязывает свежеотображённый блок к узлам согласно политике; ошибки игнорируются -
+    // неудачная привязка оставляет системное размещение по первому касанию
+    void ApplyPlacement(void* block, size_t bytes) const noexcept {
+        constexpr int kMpolBind = 2;           // MPOL_BIND
+        constexpr int kMpolInterleave = 3;     // MPOL_INTERLEAVE
+        constexpr size_t kMaxNode = sizeof(unsigned long) * 8;
+
+        if (placement == NumaPlacement::kInterleave) {
+            unsigned long mask = AllowedNodesMask();
+            syscall(SYS_mbind, block, bytes, kMpolInterleave, &mask, kMaxNode + 1, 0UL);
+        }
+        else if (placement == NumaPlacement::kBindNode) {
+            unsigned long mask = 1UL << node;
+            syscall(SYS_mbind, block, bytes, kMpolBind, &mask, kMaxNode + 1, 0UL);
+        }
+    }
+
+    // Маска NUMA-узлов, доступных текущему потоку
+    static unsigned long AllowedNodesMask() noexcept {
+        constexpr int kMemsAllowed = 1 << 2;   // MPOL_F_MEMS_ALLOWED
+        unsigned long mask = 0;
+        if (syscall(SYS_get_mempolicy, nullptr, &mask, sizeof(mask) * 8, nullptr,
+            static_cast<unsigned long>(kMemsAllowed)) != 0 || mask == 0) {
+            mask = 1;                          // одноузловая машина либо ядро без NUMA
+        }
+        return mask;
+    }
+
+    // Округляет размер блока вверх до границы страницы
+    static size_t RoundUpToPage(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const NumaAllocator<T>& lhs, const NumaAllocator<U>& rhs) noexcept {
+    return lhs.placement == rhs.placement && lhs.node == rhs.node;
+}
+template <typename T, typename U>
+bool operator!=(const NumaAllocator<T>& lhs, const NumaAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// Вектор с NUMA-размещением буфера; в паре с параллельными Resize/ForEach даёт
+// узлам локальный доступ к своей части данных
+template <typename T>
+using NumaVector = Vector<T, NumaAllocator<T>>;
+
+#endif
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "vector.h"
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+namespace bench {
+
+    // ---------------------------------------- Измерительная часть ------------------------------------
+
+    // Результат измерения одного сценария: все замеры и сводные статистики в миллисекундах
+    struct Result {
+        std::string name;
+        double median_ms = 0.0;
+        double p99_ms = 0.0;
+        double min_ms = 0.0;
+        size_t runs = 0;
+    };
+
+    // Возвращает p-ый перцентиль (0..1) по отсортированному списку замеров
+    inline double Percentile(const std::vector<double>& sorted_runs, double p) {
+        if (sorted_runs.empty()) {
+            return 0.0;
+        }
+        const size_t index = static_cast<size_t>(p * (sorted_runs.size() - 1) + 0.5);
+        return sorted_runs[std::min(index, sorted_runs.size() - 1)];
+    }
+
+    // Прогревает сценарий warmup раз, затем повторяет его runs раз и собирает статистику.
+    // Медиана и p99 по повторам устойчивы к выбросам планировщика, в отличие от одиночного замера
+    template <typename Fn>
+    Result Measure(std::string name, Fn&& fn, size_t warmup = 2, size_t runs = 11) {
+
+        for (size_t i = 0; i < warmup; ++i) {
+            fn();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(runs);
+
+        for (size_t i = 0; i < runs; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto finish = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(finish - start).count());
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = std::move(name);
+        result.median_ms = Percentile(samples, 0.5);
+        result.p99_ms = Percentile(samples, 0.99);
+        result.min_ms = samples.front();
+        result.runs = runs;
+        return result;
+    }
+
+    // Выдача результата измерения одной строкой
+    inline void Print(const Result& result) {
+        using namespace std;
+        cerr << left << setw(58) << result.name
+            << " median " << right << setw(10) << fixed << setprecision(3) << result.median_ms << " ms"
+            << "   p99 " << setw(10) << result.p99_ms << " ms"
+            << "   min " << setw(10) << result.min_ms << " ms"
+            << "   (" << result.runs << " runs)" << endl;
+    }
+
+    // ---------------------------------------- Адаптеры контейнеров -----------------------------------
+
+    // Единый интерфейс над Vector и std::vector для сценариев ниже
+
+    struct VectorOps {
+        template <typename C, typename V>
+        static void PushBack(C& container, V&& value) {
+            container.PushBack(std::forward<V>(value));
+        }
+        template <typename C, typename V>
+        static void InsertAt(C& container, size_t index, V&& value) {
+            container.Insert(container.cbegin() + index, std::forward<V>(value));
+        }
+        template <typename C>
+        static void Reserve(C& container, size_t n) {
+            container.Reserve(n);
+        }
+        template <typename C>
+        static void Resize(C& container, size_t n) {
+            container.Resize(n);
+        }
+        template <typename C>
+        static size_t Size(const C& container) {
+            return container.Size();
+        }
+    };
+
+    struct StdVectorOps {
+        template <typename C, typename V>
+        static void PushBack(C& container, V&& value) {
+            container.push_back(std::forward<V>(value));
+        }
+        template <typename C, typename V>
+        static void InsertAt(C& container, size_t index, V&& value) {
+            container.insert(container.cbegin() + index, std::forward<V>(value));
+        }
+        template <typename C>
+        static void Reserve(C& container, size_t n) {
+            container.reserve(n);
+        }
+        template <typename C>
+        static void Resize(C& container, size_t n) {
+            container.resize(n);
+        }
+        template <typename C>
+        static size_t Size(const C& container) {
+            return container.size();
+        }
+    };
+
+    // ---------------------------------------- Фабрики элементов --------------------------------------
+
+    struct MakePod {
+        uint64_t operator()(size_t i) const {
+            return static_cast<uint64_t>(i);
+        }
+    };
+    struct MakeString {
+        std::string operator()(size_t i) const {
+            return "payload-" + std::to_string(i);
+        }
+    };
+    struct MakeMoveOnly {
+        std::unique_ptr<uint64_t> operator()(size_t i) const {
+            return std::make_unique<uint64_t>(static_cast<uint64_t>(i));
+        }
+    };
+
+    // ---------------------------------------- Сценарии -----------------------------------------------
+
+    // Количество одиночных вставок в начало/середину - квадратичный сценарий ограничивается сверху
+    inline constexpr size_t kMaxInserts = 1000;
+
+    // Прогоняет полный набор сценариев для пары контейнер/тип элемента на размере n
+    template <typename Container, typename Ops, typename MakeValue>
+    void RunScenarioSet(const std::string& label, size_t n, MakeValue make) {
+
+        const std::string prefix = label + "/n=" + std::to_string(n);
+
+        Print(Measure(prefix + "/PushBack", [&] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                Ops::PushBack(c, make(i));
+            }
+        }));
+
+        Print(Measure(prefix + "/Reserve", [&] {
+            Container c;
+            Ops::Reserve(c, n);
+        }));
+
+        Print(Measure(prefix + "/Resize", [&] {
+            Container c;
+            Ops::Resize(c, n);
+        }));
+
+        const size_t inserts = std::min(n, kMaxInserts);
+
+        Print(Measure(prefix + "/InsertFront", [&] {
+            Container c;
+            Ops::Reserve(c, n + inserts);
+            Ops::Resize(c, n);
+            for (size_t i = 0; i < inserts; ++i) {
+                Ops::InsertAt(c, 0, make(i));
+            }
+        }));
+
+        Print(Measure(prefix + "/InsertMiddle", [&] {
+            Container c;
+            Ops::Reserve(c, n + inserts);
+            Ops::Resize(c, n);
+            for (size_t i = 0; i < inserts; ++i) {
+                Ops::InsertAt(c, Ops::Size(c) / 2, make(i));
+            }
+        }));
+
+        // копирующее присваивание имеет смысл только для копируемых типов
+        if constexpr (std::is_copy_assignable_v<typename Container::value_type>) {
+            Print(Measure(prefix + "/CopyAssign", [&] {
+                Container source;
+                for (size_t i = 0; i < n; ++i) {
+                    Ops::PushBack(source, make(i));
+                }
+                Container destination;
+                destination = source;
+            }));
+        }
+    }
+
+    // Сценарий с косвенностью: элементы держат указатели на разбросанные по куче блоки,
+    // замер сравнивает обычный обход с ScanWithPrefetch на нескольких дистанциях предвыборки
+    inline void RunPrefetchScan(size_t n) {
+
+        const std::string prefix = "Vector<unique_ptr>/n=" + std::to_string(n);
+
+        Vector<std::unique_ptr<uint64_t>> v;
+        v.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            v.PushBack(std::make_unique<uint64_t>(static_cast<uint64_t>(i)));
+        }
+
+        volatile uint64_t sink = 0;            // сумма не должна выбрасываться оптимизатором
+
+        Print(Measure(prefix + "/Scan", [&] {
+            uint64_t sum = 0;
+            v.ForEach([&sum](const std::unique_ptr<uint64_t>& p) {
+                sum += *p;
+            });
+            sink = sink + sum;
+        }));
+
+        for (size_t distance : { 4, 8, 16 }) {
+            Print(Measure(prefix + "/ScanWithPrefetch/d=" + std::to_string(distance), [&] {
+                uint64_t sum = 0;
+                v.ScanWithPrefetch(distance,
+                    [](const std::unique_ptr<uint64_t>& p) { return p.get(); },
+                    [&sum](const std::unique_ptr<uint64_t>& p) { sum += *p; });
+                sink = sink + sum;
+            }));
+        }
+    }
+
+    // ---------------------------------------- Точка входа --------------------------------------------
+
+    // Полный прогон: типы элементов POD / std::string / move-only на размерах 1e2..max_size.
+    // max_size по умолчанию удерживает время прогона разумным; для полного замера передать 1e7
+    inline void RunAll(size_t max_size = 1'000'000) {
+
+        std::vector<size_t> sizes;
+        for (size_t n = 100; n <= max_size; n *= 10) {
+            sizes.push_back(n);
+        }
+
+        for (size_t n : sizes) {
+            RunScenarioSet<Vector<uint64_t>, VectorOps>("Vector<uint64_t>", n, MakePod{});
+            RunScenarioSet<std::vector<uint64_t>, StdVectorOps>("std::vector<uint64_t>", n, MakePod{});
+        }
+        for (size_t n : sizes) {
+            RunScenarioSet<Vector<std::string>, VectorOps>("Vector<string>", n, MakeString{});
+            RunScenarioSet<std::vector<std::string>, StdVectorOps>("std::vector<string>", n, MakeString{});
+        }
+        for (size_t n : sizes) {
+            RunScenarioSet<Vector<std::unique_ptr<uint64_t>>, VectorOps>("Vector<unique_ptr>", n, MakeMoveOnly{});
+            RunScenarioSet<std::vector<std::unique_ptr<uint64_t>>, StdVectorOps>("std::vector<unique_ptr>", n, MakeMoveOnly{});
+        }
+        RunPrefetchScan(sizes.back());
+    }
+
+} // namespace bench
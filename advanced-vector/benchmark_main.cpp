@@ -0,0 +1,15 @@
+#include "benchmark.h"
+
+#include <cstdlib>
+
+// Отдельная цель для замеров производительности - собирается независимо от main.cpp.
+// Первый аргумент командной строки задаёт максимальный размер контейнера (по умолчанию 1e6)
+int main(int argc, char** argv) {
+
+    size_t max_size = 1'000'000;
+    if (argc > 1) {
+        max_size = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    bench::RunAll(max_size);
+}
@@ -5,5 +5,5 @@
 int main() {
 
     tests::UnitTests();            // общий UnitTest класса Vector<T>
-    tests::Benchmark();            // сравнение со стандартным std::vector
+                                   // замеры производительности вынесены в отдельную цель benchmark_main.cpp
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "vector.h"
+#include "allocators.h"
 
 #include <iostream>
 #include <stdexcept>
@@ -8,6 +9,10 @@
 #include <vector>
 #include <algorithm>
 
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
 namespace {
 
     struct IntEx {
@@ -174,8 +179,130 @@ namespace {
         static inline int num_move_assigned = 0;
     };
 
+    // Арена для проверки расширения буфера на месте (TryExtend/TryResize)
+    struct ArenaState {
+        static constexpr size_t kSize = 1 << 20;
+
+        alignas(std::max_align_t) char buf[kSize];
+        size_t used = 0;
+    };
+
+    // Бамп-аллокатор поверх арены: умеет расширять крайний выданный блок без переноса
+    template <typename T>
+    struct ArenaAllocator {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = ArenaAllocator<U>;
+        };
+
+        explicit ArenaAllocator(ArenaState* state = nullptr) noexcept
+            : state(state) {
+        }
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+            : state(other.state) {
+        }
+
+        T* allocate(size_t n) {
+            const size_t bytes = n * sizeof(T);
+            if (state->used + bytes > ArenaState::kSize) {
+                throw std::bad_alloc();
+            }
+            char* block = state->buf + state->used;
+            state->used += bytes;
+            return reinterpret_cast<T*>(block);
+        }
+        void deallocate(T*, size_t) noexcept {
+        }
+
+        // Расширяет блок на месте, если он является крайним в арене
+        bool TryResize(T* buf, size_t old_n, size_t new_n) noexcept {
+            char* block = reinterpret_cast<char*>(buf);
+            if (block + old_n * sizeof(T) != state->buf + state->used) {
+                return false;
+            }
+            const size_t extra = (new_n - old_n) * sizeof(T);
+            if (state->used + extra > ArenaState::kSize) {
+                return false;
+            }
+            state->used += extra;
+            return true;
+        }
+
+        ArenaState* state = nullptr;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+        return lhs.state == rhs.state;
+    }
+    template <typename T, typename U>
+    bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+        return lhs.state != rhs.state;
+    }
+
+    // Move-only обёртка над unique_ptr - классический тривиально перемещаемый тип:
+    // memcpy байтов плюс отказ от исходника эквивалентны move + destroy
+    struct RelocPtr {
+        explicit RelocPtr(int v) : ptr(std::make_unique<int>(v)) {
+        }
+        RelocPtr(RelocPtr&&) = default;
+        RelocPtr& operator=(RelocPtr&&) = default;
+
+        std::unique_ptr<int> ptr;
+    };
+
+    // Копируемый тип без перемещения: релокация выполняется копированием и может
+    // бросать на заданной по счёту копии - для проверки очистки при исключениях
+    struct CopyOnly {
+        explicit CopyOnly(int v = 0)
+            : value(v) {
+            ++alive;
+        }
+        CopyOnly(const CopyOnly& other)
+            : value(other.value) {
+            if (copies++ == throw_on_copy_number) {
+                throw std::runtime_error("Oops");
+            }
+            ++alive;
+        }
+        CopyOnly& operator=(const CopyOnly&) = default;
+        ~CopyOnly() {
+            --alive;
+        }
+
+        int value = 0;
+
+        static inline int alive = 0;
+        static inline int copies = 0;
+        static inline int throw_on_copy_number = -1;   // номер копии, на которой бросить (-1 - никогда)
+    };
+
+#if ADV_VECTOR_CONSTEXPR_MODE
+    // Таблица CRC-32, собираемая Vector-ом на этапе компиляции (Test 27)
+    constexpr uint32_t Crc32TableEntry(size_t index) {
+        Vector<uint32_t> table;
+        table.Reserve(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t crc = n;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1u) != 0 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            }
+            table.PushBack(crc);
+        }
+        return table[index];
+    }
+#endif
+
 }  // namespace
 
+// специализация объявляется в пространстве имён первичного шаблона
+template <>
+struct is_trivially_relocatable<RelocPtr> : std::true_type {
+};
+
 namespace tests {
 
     void UnitTests() {
@@ -631,92 +758,1045 @@ namespace tests {
                 assert(Obj::GetAliveObjectCount() == SIZE - 1);
             }
         }
-    }
 
-    // Структура для проведения бенчмарка
-    struct C {
-        C() noexcept {
-            ++def_ctor;
+        // Test 7 - SmallVector (SBO): встроенный буфер, переполнение, перемещение и Swap
+        {
+            Obj::ResetCounters();
+            {
+                SmallVector<Obj, 8> v;
+                assert(v.Capacity() == 8);
+                assert(v.Size() == 0);
+                assert(v.Data().IsInline());
+                for (int i = 0; i < 8; ++i) {
+                    v.PushBack(Obj{ i });
+                }
+                assert(v.Data().IsInline());                // до 8 элементов куча не используется
+                v.PushBack(Obj{ 8 });
+                assert(!v.Data().IsInline());               // после переполнения буфер переезжает в кучу
+                assert(v.Size() == 9);
+                for (int i = 0; i < 9; ++i) {
+                    assert(v[i].id == i);
+                }
+
+                SmallVector<Obj, 8> w(std::move(v));        // перемещение вектора с буфером в куче
+                assert(w.Size() == 9);
+                assert(v.Size() == 0);
+
+                SmallVector<Obj, 8> s;
+                s.PushBack(Obj{ 42 });
+                s.Swap(w);                                  // обмен встроенного буфера с буфером в куче
+                assert(s.Size() == 9);
+                assert(w.Size() == 1);
+                assert(w[0].id == 42);
+            }
+            assert(Obj::GetAliveObjectCount() == 0);
         }
-        C(const C& /*other*/) noexcept {
-            ++copy_ctor;
+
+        // Test 8 - Блочные операции AppendRange(), Assign(), Insert(pos, first, last)
+        {
+            const size_t SIZE = 1000;
+            {
+                std::vector<int> source(SIZE);
+                for (size_t i = 0; i < SIZE; ++i) {
+                    source[i] = static_cast<int>(i);
+                }
+
+                Vector<int> v;
+                v.AppendRange(source.begin(), source.end());
+                assert(v.Size() == SIZE);
+                assert(v.Capacity() == SIZE);               // ровно одна реаллокация под весь блок
+                assert(v[0] == 0);
+                assert(v[SIZE - 1] == static_cast<int>(SIZE) - 1);
+
+                v.AppendRange(source.begin(), source.begin() + 10);
+                assert(v.Size() == SIZE + 10);
+                assert(v[SIZE + 9] == 9);
+
+                v.Assign(source.begin(), source.begin() + 5);
+                assert(v.Size() == 5);
+                assert(v[4] == 4);
+
+                auto* pos = v.Insert(v.cbegin() + 2, source.begin() + 100, source.begin() + 103);
+                assert(v.Size() == 8);
+                assert(pos - v.begin() == 2);
+                assert(v[1] == 1);
+                assert(v[2] == 100);
+                assert(v[4] == 102);
+                assert(v[5] == 2);
+                assert(v[7] == 4);
+            }
+            {
+                Obj::ResetCounters();
+                std::vector<Obj> source(10);
+                Vector<Obj> v(10);
+                v.Insert(v.cbegin() + 5, source.begin(), source.end());
+                assert(v.Size() == 20);
+                assert(Obj::GetAliveObjectCount() == 30);
+            }
+            assert(Obj::GetAliveObjectCount() == 0);
         }
-        C(C&& /*other*/) noexcept {
-            ++move_ctor;
+
+        // Test 9 - Неинициализирующий размер: ResizeUninitialized() и конструктор с kUninitialized
+        {
+            const size_t SIZE = 4096;
+            {
+                Vector<char> v(SIZE, kUninitialized);
+                assert(v.Size() == SIZE);
+                assert(v.Capacity() == SIZE);
+            }
+            {
+                Vector<char> v;
+                v.ResizeUninitialized(SIZE);
+                assert(v.Size() == SIZE);
+                assert(v.Capacity() == SIZE);
+
+                // содержимое сохраняется при дальнейшем росте
+                v[0] = 'a';
+                v[SIZE - 1] = 'z';
+                v.ResizeUninitialized(SIZE * 2);
+                assert(v.Size() == SIZE * 2);
+                assert(v[0] == 'a');
+                assert(v[SIZE - 1] == 'z');
+
+                v.ResizeUninitialized(10);
+                assert(v.Size() == 10);
+                assert(v[0] == 'a');
+            }
         }
-        C& operator=(const C& other) noexcept {
-            if (this != &other) {
-                ++copy_assign;
+
+        // Test 10 - ShrinkToFit() и MemoryFootprint()
+        {
+            const size_t SIZE = 1000;
+            {
+                Obj::ResetCounters();
+                Vector<Obj> v;
+                v.Reserve(SIZE);
+                v.Resize(10);
+                assert(v.Capacity() == SIZE);
+
+                auto stats = v.MemoryFootprint();
+                assert(stats.allocated_bytes == SIZE * sizeof(Obj));
+                assert(stats.live_bytes == 10 * sizeof(Obj));
+
+                v.ShrinkToFit();
+                assert(v.Capacity() == 10);
+                assert(v.Size() == 10);
+                assert(Obj::GetAliveObjectCount() == 10);
+
+                v.ShrinkToFit();                            // повторный вызов ничего не делает
+                assert(v.Capacity() == 10);
+            }
+            assert(Obj::GetAliveObjectCount() == 0);
+            {
+                // SBO-вектор возвращает данные во встроенный буфер
+                SmallVector<int, 8> v;
+                for (int i = 0; i < 20; ++i) {
+                    v.PushBack(i);
+                }
+                v.Resize(4);
+                assert(!v.Data().IsInline());
+                v.ShrinkToFit();
+                assert(v.Data().IsInline());
+                assert(v.Capacity() == 8);
+                for (int i = 0; i < 4; ++i) {
+                    assert(v[i] == i);
+                }
             }
-            return *this;
         }
-        C& operator=(C&& /*other*/) noexcept {
-            ++move_assign;
-            return *this;
+
+        // Test 11 - Выравнивание буфера: переаллоцированные типы и AlignedVector
+        {
+            struct alignas(64) Lane {
+                float values[16];
+            };
+            {
+                Vector<Lane> v(10);
+                assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+                v.PushBack(Lane{});
+                assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+            }
+            {
+                AlignedVector<float> v(100);
+                assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+                for (int i = 0; i < 100; ++i) {
+                    v.PushBack(1.0f);
+                }
+                assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+            }
         }
-        ~C() {
-            ++dtor;
+
+        // Test 12 - PmrVector: память берётся у переданного memory_resource
+        {
+            alignas(std::max_align_t) char arena_buffer[64 * 1024];
+            std::pmr::monotonic_buffer_resource arena(arena_buffer, sizeof(arena_buffer),
+                std::pmr::null_memory_resource());
+
+            PmrVector<int> v(&arena);
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(i);
+            }
+            assert(v.Size() == 1000);
+            assert(v[999] == 999);
+
+            // буфер размещён внутри арены, а не в куче
+            const char* address = reinterpret_cast<const char*>(&v[0]);
+            assert(address >= arena_buffer && address < arena_buffer + sizeof(arena_buffer));
+
+            // вектор с размером и ресурсом
+            PmrVector<int> w(100, &arena);
+            assert(w.Size() == 100);
+            assert(w[0] == 0);
         }
 
-        static void Reset() {
-            def_ctor = 0;
-            copy_ctor = 0;
-            move_ctor = 0;
-            copy_assign = 0;
-            move_assign = 0;
-            dtor = 0;
+        // Test 13 - Расширение буфера на месте через ArenaAllocator::TryResize
+        {
+            auto arena = std::make_unique<ArenaState>();
+            Vector<int, ArenaAllocator<int>> v(ArenaAllocator<int>(arena.get()));
+
+            v.Reserve(8);
+            const int* buffer_before = v.begin();       // адрес начала буфера
+
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(i);
+            }
+
+            // крайний блок арены каждый раз расширялся на месте - буфер ни разу не переехал
+            assert(&v[0] == buffer_before);
+            assert(v.Size() == 1000);
+            assert(v[999] == 999);
+
+            // занятый чужим блоком хвост арены отключает расширение - буфер переезжает
+            ArenaAllocator<int>(arena.get()).allocate(1);
+            const size_t capacity_before = v.Capacity();
+            for (size_t i = v.Size(); i < capacity_before + 1; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            assert(&v[0] != buffer_before);
+            assert(v[999] == 999);
         }
 
-        inline static size_t def_ctor = 0;
-        inline static size_t copy_ctor = 0;
-        inline static size_t move_ctor = 0;
-        inline static size_t copy_assign = 0;
-        inline static size_t move_assign = 0;
-        inline static size_t dtor = 0;
-    };
+        // Test 14 - Передача владения буфером: ReleaseBuffer() и Adopt()
+        {
+            Obj::ResetCounters();
+            {
+                Vector<Obj> v(10);
+                v[3].id = 42;
+                const Obj* buffer_before = v.begin();
 
-    // Выдача информации по работе структуры
-    void Dump() {
-        using namespace std;
-        cerr << "Def ctors: "sv << C::def_ctor             //
-            << ", Copy ctors: "sv << C::copy_ctor          //
-            << ", Move ctors: "sv << C::move_ctor          //
-            << ", Copy assignments: "sv << C::copy_assign  //
-            << ", Move assignments: "sv << C::move_assign  //
-            << ", Dtors: "sv << C::dtor << endl;
-    }
+                auto released = v.ReleaseBuffer();
+                assert(released.buffer == buffer_before);
+                assert(released.size == 10);
+                assert(released.capacity == 10);
+                assert(v.Size() == 0);
+                assert(v.Capacity() == 0);
+                assert(Obj::GetAliveObjectCount() == 10);   // элементы живут в отданном буфере
+
+                // вектор пригоден к дальнейшей работе
+                v.PushBack(Obj{ 1 });
+                assert(v.Size() == 1);
+
+                // возврат владения без единого копирования
+                auto adopted = Vector<Obj>::Adopt(released.buffer, released.size, released.capacity);
+                assert(adopted.Size() == 10);
+                assert(adopted[3].id == 42);
+                assert(adopted.begin() == buffer_before);
+            }
+            assert(Obj::GetAliveObjectCount() == 0);
+        }
+
+        // Test 15 - HugePageVector: mmap-буферы с расширением на месте через mremap
+        {
+            const size_t SIZE = 4 << 20;                // 4 МБ - заведомо больше порога mmap
+            HugePageVector<char> v;
+            v.Resize(SIZE);
+            assert(v.Size() == SIZE);
+            v[0] = 'a';
+            v[SIZE - 1] = 'z';
+
+            v.Resize(SIZE * 2);                         // на Linux обычно расширяется без переноса
+            assert(v.Size() == SIZE * 2);
+            assert(v[0] == 'a');
+            assert(v[SIZE - 1] == 'z');
+
+            // переход через порог вверх и вниз: new-блок и mmap-блок корректно возвращаются
+            HugePageVector<char> small;
+            small.Resize(100);
+            small.Resize(SIZE);
+            assert(small.Size() == SIZE);
+        }
+
+        // Test 16 - Параллельные Resize() и Reserve()
+        {
+            const size_t SIZE = 1'000'000;
+            Vector<uint64_t> v;
+            v.Resize(SIZE, 4);                          // параллельная достройка
+            assert(v.Size() == SIZE);
+            assert(v[0] == 0 && v[SIZE - 1] == 0);      // value-инициализация отработала в каждом куске
+
+            for (size_t i = 0; i < SIZE; ++i) {
+                v[i] = i;
+            }
+            v.Reserve(SIZE * 2, 4);                     // параллельный перенос
+            assert(v.Capacity() == SIZE * 2);
+            assert(v[0] == 0 && v[SIZE / 2] == SIZE / 2 && v[SIZE - 1] == SIZE - 1);
+
+            v.Resize(10, 4);                            // параллельное разрушение хвоста
+            assert(v.Size() == 10);
+            assert(v[9] == 9);
+
+            v.Resize(100, 0);                           // 0 - аппаратный параллелизм
+            assert(v.Size() == 100);
+            assert(v[99] == 0);
+        }
+
+        // Test 17 - Удаление: Erase(first, last), EraseIf() и UnorderedErase()
+        {
+            Vector<int> v;
+            for (int i = 0; i < 10; ++i) {
+                v.PushBack(i);                              // 0 1 2 3 4 5 6 7 8 9
+            }
+
+            auto it = v.Erase(v.begin() + 2, v.begin() + 5);    // удаляем 2 3 4
+            assert(v.Size() == 7);
+            assert(*it == 5);
+            assert(v[0] == 0 && v[1] == 1 && v[2] == 5 && v[6] == 9);
+
+            it = v.Erase(v.begin() + 3, v.begin() + 3);         // пустой диапазон - без изменений
+            assert(v.Size() == 7);
+            assert(*it == 6);
+
+            v.Erase(v.begin() + 5, v.end());                    // удаляем хвост целиком
+            assert(v.Size() == 5);                              // 0 1 5 6 7
+            assert(v[4] == 7);
+
+            const size_t removed = v.EraseIf([](int x) { return x % 2 == 1; });
+            assert(removed == 3);                               // ушли 1 5 7
+            assert(v.Size() == 2);
+            assert(v[0] == 0 && v[1] == 6);
+
+            Vector<std::string> words;
+            words.PushBack("alpha");
+            words.PushBack("beta");
+            words.PushBack("gamma");
+            words.PushBack("delta");
+
+            auto word_it = words.UnorderedErase(words.begin() + 1);  // "delta" встаёт на место "beta"
+            assert(words.Size() == 3);
+            assert(*word_it == "delta");
+            assert(words[0] == "alpha" && words[2] == "gamma");
+
+            word_it = words.UnorderedErase(words.begin() + 2);       // удаление крайнего - без перестановки
+            assert(words.Size() == 2);
+            assert(word_it == words.end());
+        }
+
+        // Test 18 - Тривиальная перемещаемость: релокация memcpy вместо пары move + destroy
+        {
+            static_assert(is_trivially_relocatable_v<int>);
+            static_assert(is_trivially_relocatable_v<RelocPtr>);        // включена специализацией
+            static_assert(!is_trivially_relocatable_v<std::string>);
+
+            Vector<RelocPtr> v;
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(RelocPtr(i));                    // реаллокации идут через memcpy
+            }
+            for (int i = 0; i < 100; ++i) {
+                assert(*v[i].ptr == i);
+            }
+
+            v.Reserve(1000);                                // явная релокация всего буфера
+            assert(*v[0].ptr == 0 && *v[99].ptr == 99);
+
+            v.Emplace(v.begin() + 10, 777);                 // вставка со сдвигом хвоста
+            assert(*v[10].ptr == 777 && *v[11].ptr == 10 && *v[100].ptr == 99);
+
+            v.Erase(v.begin() + 10);
+            assert(*v[10].ptr == 10);
+
+            v.UnorderedErase(v.begin());                    // крайний элемент переезжает в начало
+            assert(*v[0].ptr == 99 && v.Size() == 99);
+        }
+
+        // Test 19 - Сравнение по содержимому, Find() и Contains()
+        {
+            Vector<uint32_t> a;
+            Vector<uint32_t> b;
+            for (uint32_t i = 0; i < 1000; ++i) {
+                a.PushBack(i);
+                b.PushBack(i);
+            }
+            assert(a == b);                                 // разные буферы, одинаковое содержимое
+            b[500] = 0;
+            assert(a != b);
+            b.PopBack();
+            assert(a != b);                                 // разные размеры
+
+            assert(a.Find(777) == a.begin() + 777);         // попадает в блочное SIMD-ядро
+            assert(a.Find(100'000) == a.end());
+            assert(a.Contains(0) && a.Contains(999) && !a.Contains(1000));
+
+            Vector<char> bytes;
+            for (char c : { 'a', 'b', 'c', 'd' }) {
+                bytes.PushBack(c);
+            }
+            assert(bytes.Find('c') == bytes.begin() + 2);   // однобайтовый тип - memchr
+            assert(!bytes.Contains('z'));
+
+            Vector<std::string> words;
+            words.PushBack("alpha");
+            words.PushBack("beta");
+            Vector<std::string> words_copy(words);
+            assert(words == words_copy);                    // fallback на std::equal
+            assert(words.Find("beta") == words.begin() + 1);
+            assert(!words.Contains("gamma"));
+            words_copy[1] = "delta";
+            assert(words != words_copy);
+        }
+
+        // Test 20 - Снимки copy-on-write: Snapshot() и отложенное копирование буфера
+        {
+            Vector<int> v;
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(i);
+            }
+            const int* buffer = v.cbegin();
+
+            auto snap = v.Snapshot();                       // O(1) - буфер становится общим
+            assert(snap.Size() == 100 && snap.begin() == buffer);
+            assert(v.cbegin() == buffer);                   // вектор читает тот же буфер
+
+            auto snap_copy = snap;                          // копия снимка тоже O(1)
+            assert(snap_copy.begin() == snap.begin());
+
+            v.PushBack(100);                                // первая мутация - copy-on-write
+            assert(v.Size() == 101 && v[100] == 100);
+            assert(v.cbegin() != buffer);                   // вектор переехал в собственный буфер
+            assert(snap.Size() == 100 && snap.begin() == buffer);
+            for (int i = 0; i < 100; ++i) {
+                assert(snap[i] == i);                       // снимки видят содержимое на момент снятия
+            }
 
-    // Сравнение с std::vector
-    void Benchmark() {
-        using namespace std;
-        try {
-            const size_t NUM = 10;
-            C c;
             {
-                cerr << "std::vector:"sv << endl;
-                C::Reset();
-                vector<C> v(NUM);
-                Dump();
-                v.push_back(c);
+                auto local = v.Snapshot();
+                assert(local.begin() == v.cbegin());
+            }                                               // единственный снимок умер
+            const int* own = v.cbegin();
+            v.PushBack(101);                                // владение вернулось без копирования
+            assert(v.Size() == 102 && v.cbegin() == own);
+
+            auto snap2 = v.Snapshot();
+            v[0] = -1;                                      // запись через operator[] тоже отвязывает буфер
+            assert(snap2[0] == 0 && v[0] == -1);
+
+            // снимок переживает вектор-источник
+            Vector<std::string>::SnapshotView outlive;
+            {
+                Vector<std::string> src;
+                src.PushBack("alpha");
+                src.PushBack("beta");
+                outlive = src.Snapshot();
+            }
+            assert(outlive.Size() == 2 && outlive[0] == "alpha" && outlive[1] == "beta");
+        }
+
+#ifdef __linux__
+        // Test 21 - FileBackedVector: вектор поверх отображённого в память файла
+        {
+            const char* PATH = "/tmp/av_filevec_test.bin";
+            const size_t SIZE = 100'000;
+
+            int fd = open(PATH, O_RDWR | O_CREAT | O_TRUNC, 0600);
+            assert(fd >= 0);
+            {
+                FileBackedVector<uint64_t> v{ FileBackedAllocator<uint64_t>(fd) };
+                for (uint64_t i = 0; i < SIZE; ++i) {
+                    v.PushBack(i * 3);                  // рост через ftruncate + mremap
+                }
+                assert(FlushToDisk(v));
+            }                                           // отображение снято, данные остались на диске
+
+            int fd_reopen = open(PATH, O_RDWR);
+            assert(fd_reopen >= 0);
+            {
+                auto v = MapFileVector<uint64_t>(fd_reopen);    // загрузка без чтения и копирования
+                assert(v.Size() == SIZE);
+                assert(v[0] == 0 && v[SIZE / 2] == (SIZE / 2) * 3 && v[SIZE - 1] == (SIZE - 1) * 3);
+
+                v.Reserve(SIZE * 2);
+                v.PushBack(42);
+                assert(v.Size() == SIZE + 1 && v[SIZE] == 42);
+                assert(FlushToDisk(v));
+            }
+
+            close(fd);
+            close(fd_reopen);
+            unlink(PATH);
+        }
+#endif
+
+        // Test 22 - ConcurrentAppender: многопоточная дозапись без блокировок
+        {
+            const size_t SIZE = 100'000;
+            const size_t THREADS = 4;
+
+            Vector<size_t> v;
+            v.PushBack(777);                            // дозапись продолжает существующее содержимое
+            {
+                ConcurrentAppender appender(v, SIZE + 1);
+
+                std::vector<std::thread> workers;
+                for (size_t t = 0; t < THREADS; ++t) {
+                    workers.emplace_back([&appender, t] {
+                        for (size_t i = 0; i < SIZE / THREADS; ++i) {
+                            const bool claimed = appender.TryEmplace(t);
+                            assert(claimed);
+                            (void)claimed;
+                        }
+                    });
+                }
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+
+                assert(appender.Remaining() == 0);
+                assert(!appender.TryEmplace(size_t{ 0 }));      // ёмкость исчерпана
+                appender.Seal();
+            }
+
+            assert(v.Size() == SIZE + 1);
+            assert(v[0] == 777);
+
+            // каждый поток записал ровно свою долю слотов
+            size_t per_writer[THREADS] = {};
+            for (size_t i = 1; i < v.Size(); ++i) {
+                assert(v[i] < THREADS);
+                ++per_writer[v[i]];
+            }
+            for (size_t t = 0; t < THREADS; ++t) {
+                assert(per_writer[t] == SIZE / THREADS);
+            }
+        }
+
+        // Test 23 - ForEach, Transform и Reduce: последовательный и параллельный режимы
+        {
+            const size_t SIZE = 200'000;
+            Vector<uint64_t> v;
+            v.Resize(SIZE);
+            for (size_t i = 0; i < SIZE; ++i) {
+                v[i] = i;
+            }
+
+            v.Transform([](uint64_t x) { return x * 2; });
+            assert(v[1] == 2 && v[SIZE - 1] == (SIZE - 1) * 2);
+
+            v.ForEach([](uint64_t& x) { x += 1; }, 4);          // параллельный проход с записью
+            assert(v[0] == 1 && v[SIZE - 1] == (SIZE - 1) * 2 + 1);
+
+            v.Transform([](uint64_t x) { return x - 1; }, 4);   // снова x == 2 * i
+
+            const uint64_t serial = v.Reduce(uint64_t{ 0 }, std::plus<>());
+            const uint64_t parallel = v.Reduce(uint64_t{ 0 }, std::plus<>(), 4);
+            assert(serial == parallel);
+            assert(serial == uint64_t{ SIZE } * (SIZE - 1));    // сумма 2i по i < SIZE
+
+            // константный ForEach не требует неконстантного доступа
+            const Vector<uint64_t>& cv = v;
+            uint64_t hits = 0;
+            cv.ForEach([&hits](const uint64_t& x) {
+                if (x % 4 == 0) {
+                    ++hits;
+                }
+            });
+            assert(hits == SIZE / 2);
+        }
+
+#ifdef __linux__
+        // Test 24 - NumaVector: подсказки ядру о размещении страниц по NUMA-узлам
+        {
+            const size_t SIZE = 1'000'000;
+
+            NumaVector<uint64_t> v{ NumaAllocator<uint64_t>(NumaPlacement::kInterleave) };
+            v.Resize(SIZE, 4);                          // first-touch из четырёх потоков
+            for (size_t i = 0; i < SIZE; ++i) {
+                v[i] = i;
+            }
+            assert(v.Size() == SIZE && v[SIZE - 1] == SIZE - 1);
+
+            const uint64_t sum = v.Reduce(uint64_t{ 0 }, std::plus<>(), 4);
+            assert(sum == uint64_t{ SIZE } * (SIZE - 1) / 2);
+
+            NumaVector<uint64_t> bound{ NumaAllocator<uint64_t>(NumaPlacement::kBindNode, 0) };
+            bound.Resize(1000);
+            bound.PushBack(42);                         // рост работает поверх mmap-буферов
+            assert(bound.Size() == 1001 && bound[1000] == 42);
+        }
+#endif
+
+        // Test 25 - Бинарная сериализация: SerializeTo() и DeserializeFrom()
+        {
+            Vector<uint32_t> v;
+            for (uint32_t i = 0; i < 10'000; ++i) {
+                v.PushBack(i * 7);
+            }
+
+            std::vector<char> blob;
+            v.SerializeTo([&blob](const void* data, size_t bytes) {
+                const char* raw = static_cast<const char*>(data);
+                blob.insert(blob.end(), raw, raw + bytes);
+            });
+            assert(blob.size() == sizeof(VectorBlobHeader) + v.Size() * sizeof(uint32_t));
+
+            auto restored = Vector<uint32_t>::DeserializeFrom(blob.data(), blob.size());
+            assert(restored == v);
+
+            // пустой вектор - только заголовок
+            Vector<uint32_t> empty;
+            std::vector<char> empty_blob;
+            empty.SerializeTo([&empty_blob](const void* data, size_t bytes) {
+                const char* raw = static_cast<const char*>(data);
+                empty_blob.insert(empty_blob.end(), raw, raw + bytes);
+            });
+            assert(empty_blob.size() == sizeof(VectorBlobHeader));
+            assert(Vector<uint32_t>::DeserializeFrom(empty_blob.data(), empty_blob.size()).Size() == 0);
+
+            // несовместимые образы отклоняются
+            bool thrown = false;
+            try {
+                auto bad = Vector<uint64_t>::DeserializeFrom(blob.data(), blob.size());
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;                          // element_size не совпадает
+            }
+            assert(thrown);
+
+            thrown = false;
+            try {
+                auto bad = Vector<uint32_t>::DeserializeFrom(blob.data(), sizeof(VectorBlobHeader) / 2);
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;                          // усечённый заголовок
+            }
+            assert(thrown);
+
+            blob[0] = 'X';                              // портим магическую константу
+            thrown = false;
+            try {
+                auto bad = Vector<uint32_t>::DeserializeFrom(blob.data(), blob.size());
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            assert(thrown);
+        }
+
+        // Test 26 - InsertSorted(): слияние отсортированного батча за один проход
+        {
+            Vector<int> v;
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(i * 2);                      // чётные по возрастанию
+            }
+
+            std::vector<int> batch;
+            for (int i = 0; i < 500; ++i) {
+                batch.push_back(i * 4 + 1);             // нечётные по возрастанию
+            }
+            v.InsertSorted(batch.begin(), batch.end());
+            assert(v.Size() == 1500);
+            assert(std::is_sorted(v.cbegin(), v.cend()));
+            assert(v[0] == 0 && v[1] == 1 && v[2] == 2);
+
+            // дубликаты и элементы за пределами текущего диапазона
+            std::vector<int> edges{ -5, 0, 0, 10'000 };
+            v.InsertSorted(edges.begin(), edges.end());
+            assert(v.Size() == 1504);
+            assert(std::is_sorted(v.cbegin(), v.cend()));
+            assert(v[0] == -5 && v[v.Size() - 1] == 10'000);
+
+            v.InsertSorted(edges.end(), edges.end());   // пустой батч - без изменений
+            assert(v.Size() == 1504);
+
+            // нетривиальный тип сливается присваиванием и копированием
+            Vector<std::string> words;
+            words.PushBack("bb");
+            words.PushBack("dd");
+            std::vector<std::string> word_batch{ "aa", "cc", "ee" };
+            words.InsertSorted(word_batch.begin(), word_batch.end());
+            assert(words.Size() == 5);
+            assert(words[0] == "aa" && words[1] == "bb" && words[2] == "cc"
+                && words[3] == "dd" && words[4] == "ee");
+
+            // исключение посреди слияния: достроенный за старым концом суффикс
+            // не должен утечь - базовая гарантия из описания метода
+            CopyOnly::alive = 0;
+            {
+                Vector<CopyOnly> sorted;
+                for (int i = 0; i < 4; ++i) {
+                    sorted.PushBack(CopyOnly(i * 2));          // 0, 2, 4, 6
+                }
+                sorted.Reserve(8);                             // слияние без реаллокации
+                std::vector<CopyOnly> odd;
+                for (int i = 0; i < 3; ++i) {
+                    odd.emplace_back(i * 2 + 1);               // 1, 3, 5
+                }
+                const auto by_value = [](const CopyOnly& l, const CopyOnly& r) {
+                    return l.value < r.value;
+                };
+
+                CopyOnly::copies = 0;
+                CopyOnly::throw_on_copy_number = 2;            // третья копия - переезд хвоста в сырую память
+                const int alive_before = CopyOnly::alive;
+                bool thrown = false;
+                try {
+                    sorted.InsertSorted(odd.begin(), odd.end(), by_value);
+                }
+                catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                assert(thrown);
+                assert(CopyOnly::alive == alive_before);       // суффикс за старым концом разрушен
+                assert(sorted.Size() == 4);
+
+                // повторное слияние без исключений доводит работу до конца
+                CopyOnly::throw_on_copy_number = -1;
+                sorted.InsertSorted(odd.begin(), odd.end(), by_value);
+                assert(sorted.Size() == 7);
+                assert(std::is_sorted(sorted.begin(), sorted.end(), by_value));
+            }
+            assert(CopyOnly::alive == 0);
+        }
+
+#if ADV_VECTOR_CONSTEXPR_MODE
+        // Test 27 - constexpr-режим (сборка с -std=c++20): вектор работает в констант-вычислениях
+        {
+            static_assert(Crc32TableEntry(0) == 0x00000000u);
+            static_assert(Crc32TableEntry(1) == 0x77073096u);
+            static_assert(Crc32TableEntry(255) == 0x2D02EF8Du);
+
+            // рост буфера, Resize и PopBack целиком на этапе компиляции
+            constexpr size_t sum = [] {
+                Vector<int> v;
+                for (int i = 0; i < 10; ++i) {
+                    v.PushBack(i);                  // с реаллокациями по политике роста
+                }
+                v.Resize(12);
+                v.PopBack();
+                size_t acc = 0;
+                for (size_t i = 0; i < v.Size(); ++i) {
+                    acc += static_cast<size_t>(v[i]);
+                }
+                return acc;
+            }();
+            static_assert(sum == 45);
+        }
+#endif
+
+        // Test 28 - At() с обязательной проверкой диапазона и срезы Span()
+        {
+            Vector<int> v;
+            for (int i = 0; i < 10; ++i) {
+                v.PushBack(i);
+            }
+
+            assert(v.At(0) == 0 && v.At(9) == 9);
+            v.At(3) = 33;
+            assert(v[3] == 33);
+
+            bool thrown = false;
+            try {
+                v.At(10) = 1;
+            }
+            catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            assert(thrown);
+
+            const Vector<int>& cv = v;
+            assert(cv.At(3) == 33);
+            thrown = false;
+            try {
+                (void)cv.At(100);
             }
-            Dump();
+            catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            assert(thrown);
+
+            // срез без проверок: запись через __restrict-указатель и range-for
+            auto span = v.Span();
+            assert(span.Size() == v.Size() && span.data == v.begin());
+            span[3] = 3;
+            int sum = 0;
+            for (int value : span) {
+                sum += value;
+            }
+            assert(sum == 45);
+
+            auto cspan = cv.Span();
+            static_assert(std::is_same_v<decltype(cspan[0]), const int&>);
+            assert(cspan.Size() == 10 && cspan[9] == 9);
+
+            // неконстантный срез отвязывает буфер от живых снимков
+            auto snap = v.Snapshot();
+            auto detached = v.Span();
+            assert(detached.data != snap.begin());
+            assert(std::equal(detached.begin(), detached.end(), snap.begin()));
         }
-        catch (...) {
+
+        // Test 29 - PooledVector: переиспользование буферов через пул потока
+        {
+            PooledAllocator<int>::TrimLocalPool();
+            assert(PooledAllocator<int>::LocalPoolBlocks() == 0);
+
+            const int* retired = nullptr;
+            {
+                PooledVector<int> v;
+                for (int i = 0; i < 1000; ++i) {
+                    v.PushBack(i);
+                }
+                assert(v.Capacity() == 1024);
+                retired = v.begin();
+            }
+            // деструктор вернул в пул финальный буфер и буферы промежуточных реаллокаций
+            assert(PooledAllocator<int>::LocalPoolBlocks() > 0);
+
+            // запрос того же класса ёмкости обслуживается из пула без обращения к куче
+            PooledVector<int> w(1024);
+            assert(w.begin() == retired);
+            w[1023] = 42;
+            assert(w[1023] == 42 && w[0] == 0);
+
+            // запросы разной ёмкости из одного класса переиспользуют один и тот же блок
+            {
+                const int* reuse = nullptr;
+                {
+                    PooledVector<int> s;
+                    s.Reserve(600);            // 2400 байт - класс 4096
+                    reuse = s.begin();
+                }
+                PooledVector<int> t;
+                t.Reserve(1000);               // 4000 байт - тот же класс
+                assert(t.begin() == reuse);
+            }
+
+            PooledAllocator<int>::TrimLocalPool();
+            assert(PooledAllocator<int>::LocalPoolBlocks() == 0);
+        }
+
+        // Test 30 - ScanWithPrefetch(): обход с предвыборкой адресов за указателями
+        {
+            Vector<std::unique_ptr<int>> v;
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(std::make_unique<int>(i));
+            }
+
+            const auto project = [](const std::unique_ptr<int>& p) { return p.get(); };
+
+            long long sum = 0;
+            v.ScanWithPrefetch(8, project, [&sum](const std::unique_ptr<int>& p) {
+                sum += *p;
+            });
+            assert(sum == 999 * 1000 / 2);
+
+            // дистанция больше размера: предвыборка не выполняется, обход корректен
+            sum = 0;
+            v.ScanWithPrefetch(5000, project, [&sum](const std::unique_ptr<int>& p) {
+                sum += *p;
+            });
+            assert(sum == 999 * 1000 / 2);
+
+            // неконстантная версия допускает запись в элементы
+            Vector<int> w;
+            for (int i = 0; i < 100; ++i) {
+                w.PushBack(i);
+            }
+            w.ScanWithPrefetch(4, [](int& x) { return &x; }, [](int& x) { x *= 2; });
+            assert(w[50] == 100);
+
+            // константная версия
+            const Vector<int>& cw = w;
+            int total = 0;
+            cw.ScanWithPrefetch(4, [](const int& x) { return &x; }, [&total](const int& x) {
+                total += x;
+            });
+            assert(total == 99 * 100);
+        }
+
+        // Test 31 - Перемещение между буферами совпадающей ёмкости
+        {
+            // перемещающее присваивание: совпадение ёмкостей не должно пропускать перенос
+            Vector<std::string> a;
+            a.PushBack("left");
+            Vector<std::string> b;
+            b.PushBack("right-side-payload-long-enough-for-the-heap");
+            assert(a.Capacity() == b.Capacity());
+
+            const std::string* source = b.begin();
+            a = std::move(b);
+            assert(a.Size() == 1);
+            assert(a[0] == "right-side-payload-long-enough-for-the-heap");
+            assert(a.begin() == source);       // буфер переехал указателем, а не копией
+
+            // перемещающий конструктор от вектора той же ёмкости
+            Vector<std::string> c(std::move(a));
+            assert(c.Size() == 1 && c.begin() == source);
+            assert(c[0] == "right-side-payload-long-enough-for-the-heap");
         }
-        try {
-            const size_t NUM = 10;
-            C c;
+
+        // Test 32 - Перемещение пустого вектора сохраняет stateful-аллокатор
+        {
+            auto arena = std::make_unique<ArenaState>();
+            using ArenaVector = Vector<int, ArenaAllocator<int>>;
+
+            // перемещающий конструктор от пустого источника переносит аллокатор
+            ArenaVector a{ ArenaAllocator<int>(arena.get()) };
+            ArenaVector b(std::move(a));
+            b.PushBack(1);
+            assert(arena->used >= sizeof(int));            // память пришла из арены
+            assert(b[0] == 1);
+
+            // перемещающее присваивание пустого источника тоже
+            ArenaVector c{ ArenaAllocator<int>(arena.get()) };
+            ArenaVector d;                                 // аллокатор без арены
+            d = std::move(c);
+            const size_t used_before = arena->used;
+            d.PushBack(2);
+            assert(arena->used > used_before);
+            assert(d[0] == 2);
+
+            // со встроенным буфером перенос поэлементный, но аллокатор тоже обязан переехать:
+            // иначе первый рост за InlineCapacity выделит память не из той арены
+            using SmallArenaVector = SmallVector<int, 4, ArenaAllocator<int>>;
+            SmallArenaVector e{ ArenaAllocator<int>(arena.get()) };
+            e.PushBack(3);                                 // содержимое целиком во встроенном буфере
+            SmallArenaVector f(std::move(e));
+            SmallArenaVector g;
+            g = std::move(f);
+            const size_t used_before_growth = arena->used;
+            for (int i = 0; i < 8; ++i) {                  // рост за пределы встроенного буфера
+                g.PushBack(i);
+            }
+            assert(arena->used > used_before_growth);      // память пришла из арены источника
+            assert(g[0] == 3);
+        }
+
+        // Test 33 - Очистка временного буфера при исключении в реаллоцирующем range-Insert
+        {
+            CopyOnly::alive = 0;
+
             {
-                cerr << "Vector:"sv << endl;
-                C::Reset();
-                Vector<C> v(NUM);
-                Dump();
-                v.PushBack(c);
+                Vector<CopyOnly> v;
+                v.Resize(8);                               // ёмкость заполнена точно - вставка реаллоцирует
+                std::vector<CopyOnly> batch(4);
+
+                // бросок при переносе префикса: вставленный диапазон должен быть разрушен
+                CopyOnly::copies = 0;
+                CopyOnly::throw_on_copy_number = 6;        // 4 копии батча + 2 копии префикса
+                bool thrown = false;
+                try {
+                    v.Insert(v.cbegin() + 4, batch.begin(), batch.end());
+                }
+                catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                assert(thrown);
+                assert(v.Size() == 8);                     // вектор не изменился
+
+                // бросок при переносе суффикса: префикс и вставка должны быть разрушены
+                CopyOnly::copies = 0;
+                CopyOnly::throw_on_copy_number = 10;       // 4 батча + 4 префикса + 2 суффикса
+                thrown = false;
+                try {
+                    v.Insert(v.cbegin() + 4, batch.begin(), batch.end());
+                }
+                catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                assert(thrown);
+                assert(v.Size() == 8);
+
+                // вставка без реаллокации: запас ёмкости переводит Insert на ветку на месте
+                CopyOnly::throw_on_copy_number = -1;
+                v.Reserve(16);
+                std::vector<CopyOnly> wide(6);             // count >= tail_len при вставке в середину
+
+                // бросок при достройке части батча за старым концом: вектор не трогается
+                CopyOnly::copies = 0;
+                CopyOnly::throw_on_copy_number = 1;        // вторая копия хвостовой части батча
+                thrown = false;
+                try {
+                    v.Insert(v.cbegin() + 4, wide.begin(), wide.end());
+                }
+                catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                assert(thrown);
+                assert(v.Size() == 8);
+
+                // бросок при переезде хвоста: достроенная часть батча должна быть разрушена
+                CopyOnly::copies = 0;
+                CopyOnly::throw_on_copy_number = 4;        // 2 копии батча + 2 копии хвоста
+                thrown = false;
+                try {
+                    v.Insert(v.cbegin() + 4, wide.begin(), wide.end());
+                }
+                catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                assert(thrown);
+                assert(v.Size() == 8);
+
+                // после неудач вставка на том же месте завершается успешно
+                CopyOnly::copies = 0;
+                CopyOnly::throw_on_copy_number = -1;
+                v.Insert(v.cbegin() + 4, wide.begin(), wide.end());
+                assert(v.Size() == 14);
+                assert(v.Capacity() == 16);
+            }
+
+            assert(CopyOnly::alive == 0);                  // ни один объект не утёк
+        }
+
+        // Test 34 - Политики роста Growth1_5x и GrowthExact
+        {
+            Vector<int, std::allocator<int>, 0, GrowthExact> exact;
+            for (int i = 0; i < 100; ++i) {
+                exact.PushBack(i);
+                assert(exact.Capacity() == exact.Size());  // точный рост: ни элемента про запас
+            }
+            exact.Emplace(exact.cbegin() + 50, -1);        // вставка в заполненный вектор тоже точная
+            assert(exact.Size() == 101);
+            assert(exact.Capacity() == exact.Size());
+            assert(exact[49] == 49 && exact[50] == -1 && exact[51] == 50);
+
+            Vector<int, std::allocator<int>, 0, Growth1_5x> gentle;
+            for (int i = 0; i < 100; ++i) {
+                gentle.PushBack(i);
+            }
+            assert(gentle.Size() == 100);
+            assert(gentle.Capacity() == 139);              // траектория 1,2,4,7,11,17,26,40,61,92,139
+            for (int i = 0; i < 100; ++i) {
+                assert(gentle[i] == i);
             }
-            Dump();
         }
-        catch (...) {
+
+#ifdef ADV_VECTOR_STATS
+        // Test 35 - Счётчики реаллокаций (только при сборке с ADV_VECTOR_STATS)
+        {
+            GlobalVectorStats::Reset();
+            Vector<int> v;
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(i);
+            }
+
+            const auto& stats = v.Stats();
+            assert(stats.reallocations == 8);               // 1, 2, 4, ..., 128
+            assert(stats.peak_capacity == 128);
+            assert(stats.relocated_elements == 127);        // 1 + 2 + ... + 64
+            assert(stats.allocated_bytes >= 128 * sizeof(int));
+            assert(GlobalVectorStats::reallocations == 8);
+            assert(GlobalVectorStats::allocated_bytes >= stats.allocated_bytes);
         }
+#endif
     }
 
 } // namespace tests
\ No newline at end of file
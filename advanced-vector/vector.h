@@ -3,145 +3,689 @@
 #include <new>
 #include <memory>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <utility>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <stdexcept>
 #include <type_traits>
+#include <memory_resource>
+
+#ifdef ADV_VECTOR_STATS
+// Счётчики инструментирования одного вектора (активны только при сборке с ADV_VECTOR_STATS)
+struct VectorStats {
+    size_t reallocations = 0;                  // сколько раз буфер переезжал
+    size_t relocated_elements = 0;             // сколько элементов перемещено/скопировано при переездах
+    size_t peak_capacity = 0;                  // максимальная ёмкость за время жизни
+    size_t allocated_bytes = 0;                // суммарно запрошено байт у аллокатора
+};
+
+// Глобальный агрегат счётчиков по всем векторам процесса - точка съёма для мониторинга
+struct GlobalVectorStats {
+    inline static std::atomic<size_t> reallocations{ 0 };
+    inline static std::atomic<size_t> relocated_elements{ 0 };
+    inline static std::atomic<size_t> allocated_bytes{ 0 };
+
+    static void Reset() noexcept {
+        reallocations = 0;
+        relocated_elements = 0;
+        allocated_bytes = 0;
+    }
+};
+#endif
+
+// Режим констант-вычислений: начиная с C++20 динамическое выделение памяти доступно
+// в constexpr, и ядро Vector<T> со стандартным аллокатором (без SBO) пригодно для
+// сборки таблиц на этапе компиляции. Макрос расставлен по функциям этого ядра;
+// в C++17 он пуст и сборка не меняется
+#if __cplusplus > 201703L && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define ADV_VECTOR_CONSTEXPR constexpr
+#define ADV_VECTOR_CONSTEXPR_MODE 1
+#else
+#define ADV_VECTOR_CONSTEXPR
+#define ADV_VECTOR_CONSTEXPR_MODE 0
+#endif
+
+// Конструирует элемент в сырой памяти; в констант-вычислениях placement new
+// недоступен и замещается std::construct_at
+template <typename T, typename... Args>
+ADV_VECTOR_CONSTEXPR T* ConstructAt(T* location, Args&&... args) {
+#if ADV_VECTOR_CONSTEXPR_MODE
+    if (std::is_constant_evaluated()) {
+        return std::construct_at(location, std::forward<Args>(args)...);
+    }
+#endif
+    return ::new (static_cast<void*>(location)) T(std::forward<Args>(args)...);
+}
+
+// Опциональная характеристика "тривиальной перемещаемости": тип тривиально
+// перемещаем, если memcpy в новое место плюс отказ от исходника эквивалентны
+// паре перемещение + разрушение. По умолчанию выводится из тривиальной
+// копируемости; для собственных типов (обёртки unique_ptr, структуры со
+// string_view и т.п.) допускается специализация:
+//     template <> struct is_trivially_relocatable<MyType> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Переносит count живых элементов из from в сырую память to.
+// Для тривиально-перемещаемых типов выполняется одним memcpy всего диапазона,
+// иначе - поэлементным перемещением или копированием в зависимости от типа
+template <typename T>
+ADV_VECTOR_CONSTEXPR void RelocateData(T* from, size_t count, T* to) {
+#if ADV_VECTOR_CONSTEXPR_MODE
+    if (std::is_constant_evaluated()) {
+        // memcpy и std::uninitialized_* в констант-вычислениях недоступны - поэлементно
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (std::is_move_constructible_v<T>) {
+                std::construct_at(to + i, std::move(from[i]));
+            }
+            else {
+                std::construct_at(to + i, from[i]);
+            }
+        }
+        return;
+    }
+#endif
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (count != 0) {
+            // подсказка оптимизатору: живых элементов не бывает больше половины адресного
+            // пространства. Без неё GCC при -O2 выводит для count невозможный верхний
+            // диапазон и выдаёт на memcpy ложные -Wstringop-overflow/-Wrestrict
+            if (count > static_cast<size_t>(-1) / 2 / sizeof(T)) {
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_unreachable();
+#endif
+            }
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        }
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move_n(from, count, to);
+    }
+    else {
+        std::uninitialized_copy_n(from, count, to);
+    }
+}
+
+// Разрушает исходный диапазон после RelocateData. Для тривиально-перемещаемых
+// типов исходник после memcpy считается брошенным и разрушать нечего -
+// пара перенос + разрушение сворачивается в один memcpy
+template <typename T>
+ADV_VECTOR_CONSTEXPR void DestroyRelocated(T* from, size_t count) noexcept {
+#if ADV_VECTOR_CONSTEXPR_MODE
+    if (std::is_constant_evaluated()) {
+        std::destroy_n(from, count);           // констант-вычисления требуют явного разрушения каждого объекта
+        return;
+    }
+#endif
+    if constexpr (!is_trivially_relocatable_v<T>) {
+        std::destroy_n(from, count);
+    }
+    else {
+        (void)from;
+        (void)count;
+    }
+}
+
+// Истина, если равенство значений T эквивалентно побайтовому сравнению их
+// представлений - целые типы и структуры без паддинга. Типы с плавающей точкой
+// исключаются автоматически (-0.0 == 0.0 при разных битах, NaN != NaN при равных)
+template <typename T>
+inline constexpr bool is_trivially_comparable_v = std::has_unique_object_representations_v<T>;
+
+// Поиск первого вхождения value в диапазоне [first, last).
+// Однобайтовые тривиально-сравнимые типы уходят в memchr; для прочих
+// тривиально-сравнимых диапазон обрабатывается блоками по 8 элементов -
+// ранний выход выносится из внутреннего цикла и компилятор сворачивает
+// сравнения блока в широкие SIMD-инструкции. Иначе - обычный std::find
+template <typename T>
+const T* FindValue(const T* first, const T* last, const T& value) {
+    if constexpr (is_trivially_comparable_v<T> && sizeof(T) == 1) {
+        unsigned char byte;
+        std::memcpy(&byte, &value, 1);
+        const void* found = std::memchr(first, byte, static_cast<size_t>(last - first));
+        return found != nullptr ? static_cast<const T*>(found) : last;
+    }
+    else if constexpr (is_trivially_comparable_v<T>) {
+        constexpr size_t kBlock = 8;
+        const T* ptr = first;
+        for (; static_cast<size_t>(last - ptr) >= kBlock; ptr += kBlock) {
+            bool hit = false;
+            for (size_t i = 0; i < kBlock; ++i) {
+                hit |= (ptr[i] == value);                   // без ветвления внутри блока
+            }
+            if (hit) {
+                break;
+            }
+        }
+        for (; ptr != last; ++ptr) {
+            if (*ptr == value) {
+                return ptr;
+            }
+        }
+        return last;
+    }
+    else {
+        return std::find(first, last, value);
+    }
+}
+
+// Программная предвыборка строки кэша по адресу для последующего чтения.
+// На компиляторах без __builtin_prefetch не генерирует кода
+inline void PrefetchRead(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 1);
+#else
+    (void)address;
+#endif
+}
+
+// Разрезает диапазон из total элементов на куски по числу потоков и выполняет
+// fn(offset, count) над каждым куском в отдельном потоке. thread_count == 0 означает
+// аппаратный параллелизм; при одном потоке или малом объёме работа выполняется на месте.
+// fn не должна бросать исключений - куски выполняются без общей точки отката
+template <typename Fn>
+void ParallelChunks(size_t total, size_t thread_count, Fn fn) {
+
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+
+    // порог, ниже которого запуск потоков дороже самой работы
+    constexpr size_t kMinPerThread = 4096;
+    thread_count = std::min(thread_count, std::max<size_t>(1, total / kMinPerThread));
+
+    if (thread_count <= 1) {
+        fn(size_t{ 0 }, total);
+        return;
+    }
+
+    const size_t chunk = (total + thread_count - 1) / thread_count;
+    std::unique_ptr<std::thread[]> workers(new std::thread[thread_count - 1]);
+
+    size_t offset = 0;
+    for (size_t i = 0; i + 1 < thread_count; ++i) {
+        workers[i] = std::thread(fn, offset, chunk);
+        offset += chunk;
+    }
+    fn(offset, total - offset);                        // свой кусок текущий поток делает сам
+
+    for (size_t i = 0; i + 1 < thread_count; ++i) {
+        workers[i].join();
+    }
+}
+
+// Динамическая раздача работы: диапазон из total элементов режется на куски
+// фиксированного размера, потоки разбирают их через общий атомарный счётчик -
+// быстрые потоки берут больше кусков и медленный кусок не тормозит остальных
+// (та же балансировка, что у пула с перехватом работы, без очередей на поток).
+// fn(offset, count) не должна бросать исключений
+template <typename Fn>
+void ParallelClaimChunks(size_t total, size_t thread_count, Fn fn) {
+
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+
+    // кусок фиксированного размера: достаточно крупный, чтобы счётчик не грелся,
+    // достаточно мелкий, чтобы раздача выравнивала нагрузку
+    constexpr size_t kChunk = 4096;
+    const size_t num_chunks = (total + kChunk - 1) / kChunk;
+    thread_count = std::min(thread_count, num_chunks);
+
+    if (thread_count <= 1) {
+        fn(size_t{ 0 }, total);
+        return;
+    }
+
+    std::atomic<size_t> next_chunk{ 0 };
+    auto worker = [total, num_chunks, &next_chunk, &fn]() {
+        for (size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            chunk < num_chunks;
+            chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+
+            const size_t offset = chunk * kChunk;
+            fn(offset, total - offset < kChunk ? total - offset : kChunk);
+        }
+    };
+
+    std::unique_ptr<std::thread[]> workers(new std::thread[thread_count - 1]);
+    for (size_t i = 0; i + 1 < thread_count; ++i) {
+        workers[i] = std::thread(worker);
+    }
+    worker();                                          // текущий поток разбирает куски наравне с остальными
+
+    for (size_t i = 0; i + 1 < thread_count; ++i) {
+        workers[i].join();
+    }
+}
+
+// Проверка наличия у аллокатора расширения буфера на месте:
+// bool TryResize(T* buf, size_t old_n, size_t new_n) - true, если буфер расширен без переноса
+template <typename A, typename T, typename = void>
+struct HasTryResize : std::false_type {};
+
+template <typename A, typename T>
+struct HasTryResize<A, T, std::void_t<decltype(std::declval<A&>().TryResize(
+    std::declval<T*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+// Встроенное хранилище под N элементов типа T для SBO-режима RawMemory.
+// Специализация для N == 0 не занимает места и не предоставляет буфера
+template <typename T, size_t N>
+struct InlineBuffer {
+    T* Data() noexcept {
+        return reinterpret_cast<T*>(buf_);
+    }
+    const T* Data() const noexcept {
+        return reinterpret_cast<const T*>(buf_);
+    }
+
+    alignas(T) unsigned char buf_[N * sizeof(T)];
+};
 
 template <typename T>
-class RawMemory {
+struct InlineBuffer<T, 0> {
+    constexpr T* Data() noexcept {
+        return nullptr;
+    }
+    constexpr const T* Data() const noexcept {
+        return nullptr;
+    }
+};
+
+template <typename T, typename Alloc = std::allocator<T>, size_t InlineCapacity = 0>
+class RawMemory : private InlineBuffer<T, InlineCapacity> {
 public:
 
+    using allocator_type = Alloc;
+    static constexpr size_t kInlineCapacity = InlineCapacity;
+
     // ---------------------------------------- Блок конструкторов --------------------------------------
 
-    RawMemory() = default;
+    ADV_VECTOR_CONSTEXPR RawMemory() noexcept {
+        ResetToInline();
+    }
+
+    ADV_VECTOR_CONSTEXPR explicit RawMemory(const Alloc& alloc)
+        : alloc_(alloc) {
+        ResetToInline();
+    }
 
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
-    RawMemory(RawMemory&& other) noexcept { 
-        if (*this != other) {
-            capacity_ = std::move(other.Capacity());
+    ADV_VECTOR_CONSTEXPR RawMemory(RawMemory&& other) noexcept {
+        // встроенный буфер не переносится указателем - этот случай разбирает Vector;
+        // аллокатор переезжает всегда, даже когда переносить нечего
+        ResetToInline();
+        ReplaceAllocator(other.alloc_);
+        if (!other.IsInline()) {
+            capacity_ = other.Capacity();
             buffer_ = other.GetAddress();
 
             other.buffer_ = nullptr;
             other.capacity_ = 0;
+            other.ResetToInline();
         }
     }
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
-        if (*this != rhs) {
-            capacity_ = std::move(rhs.Capacity());
-            buffer_ = rhs.GetAddress();
-
-            rhs.buffer_ = nullptr;
-            rhs.capacity_ = 0;
+    ADV_VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& rhs) noexcept {
+        // защита только от самоприсваивания: сравнение буферов по содержимому
+        // молча пропускало перенос при случайном совпадении ёмкостей
+        if (this != &rhs) {
+            Deallocate();
+            buffer_ = nullptr;
+            capacity_ = 0;
+            ResetToInline();
+            ReplaceAllocator(rhs.alloc_);
+
+            if (!rhs.IsInline()) {
+                capacity_ = rhs.Capacity();
+                buffer_ = rhs.GetAddress();
+
+                rhs.buffer_ = nullptr;
+                rhs.capacity_ = 0;
+                rhs.ResetToInline();
+            }
         }
         return *this;
     }
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    // Принимает владение готовым буфером, совместимым с Deallocate данного аллокатора
+    RawMemory(T* buf, size_t capacity, const Alloc& alloc = Alloc()) noexcept
+        : alloc_(alloc)
+        , buffer_(buf)
         , capacity_(capacity) {
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    ADV_VECTOR_CONSTEXPR explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        // пока запрошенная ёмкость умещается во встроенный буфер - куча не используется
+        if (capacity <= kInlineCapacity) {
+            ResetToInline();
+        }
+        else {
+            buffer_ = Allocate(capacity);
+            capacity_ = capacity;
+        }
+    }
+
+    ADV_VECTOR_CONSTEXPR ~RawMemory() {
+        Deallocate();
 
     }
 
     // ---------------------------------------- Блок получения значений элементов аллокатора ------------
 
-    T* operator+(size_t offset) noexcept {
+    ADV_VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
-    const T* operator+(size_t offset) const noexcept {
+    ADV_VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    ADV_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
-    T& operator[](size_t index) noexcept {
+    ADV_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < capacity_);
         return buffer_[index];
     }
 
-    const T* GetAddress() const noexcept {
+    ADV_VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
         return buffer_;
     }
-    T* GetAddress() noexcept {
+    ADV_VECTOR_CONSTEXPR T* GetAddress() noexcept {
         return buffer_;
     }
 
     // ---------------------------------------- Блок получения параметров и прочие методы ---------------
 
-    size_t Capacity() const {
+    ADV_VECTOR_CONSTEXPR size_t Capacity() const {
         return capacity_;
     }
+    ADV_VECTOR_CONSTEXPR const Alloc& GetAllocator() const noexcept {
+        return alloc_;
+    }
+    // Сообщает, указывает ли буфер на встроенное хранилище
+    ADV_VECTOR_CONSTEXPR bool IsInline() const noexcept {
+        if constexpr (kInlineCapacity > 0) {
+            return buffer_ == this->Data();
+        }
+        else {
+            return false;
+        }
+    }
     void Swap(RawMemory& other) noexcept {
+        // обмен указателями допустим только между буферами в куче,
+        // встроенные буферы обмениваются поэлементно на уровне Vector
+        assert(!IsInline() && !other.IsInline());
+        Alloc this_alloc(alloc_);
+        ReplaceAllocator(other.alloc_);
+        other.ReplaceAllocator(this_alloc);
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
+    // Отдаёт указатель на буфер вместе с владением; объект переходит в пустое состояние
+    ADV_VECTOR_CONSTEXPR T* Release() noexcept {
+        assert(!IsInline());
+        T* buffer = buffer_;
+        buffer_ = nullptr;
+        capacity_ = 0;
+        ResetToInline();
+        return buffer;
+    }
+    // Пытается расширить существующий буфер до new_capacity без переноса данных.
+    // Возможно только для аллокаторов с поддержкой TryResize (арена, mmap и т.п.)
+    ADV_VECTOR_CONSTEXPR bool TryExtend(size_t new_capacity) {
+        if constexpr (HasTryResize<Alloc, T>::value) {
+            if (buffer_ != nullptr && !IsInline() && new_capacity > capacity_
+                && alloc_.TryResize(buffer_, capacity_, new_capacity)) {
+                capacity_ = new_capacity;
+                return true;
+            }
+        }
+        (void)new_capacity;
+        return false;
+    }
+    // Возвращает буфер из кучи во встроенное хранилище, перемещая count живых элементов.
+    // Применимо только при count <= kInlineCapacity
+    void MoveToInline(size_t count) {
+        if constexpr (kInlineCapacity > 0) {
+            assert(count <= kInlineCapacity);
+            if (IsInline()) {
+                return;
+            }
+
+            T* old_buffer = buffer_;
+            const size_t old_capacity = capacity_;
+
+            RelocateData(old_buffer, count, this->Data());
+            DestroyRelocated(old_buffer, count);
+            ResetToInline();
+
+            std::allocator_traits<Alloc>::deallocate(alloc_, old_buffer, old_capacity);
+        }
+    }
 
 private:
-    // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    // Заменяет аллокатор пересозданием на месте: присваивание у некоторых
+    // аллокаторов (std::pmr::polymorphic_allocator) удалено, копирующий конструктор есть всегда
+    ADV_VECTOR_CONSTEXPR void ReplaceAllocator(const Alloc& alloc) noexcept {
+#if ADV_VECTOR_CONSTEXPR_MODE
+        if constexpr (std::is_copy_assignable_v<Alloc>) {
+            if (std::is_constant_evaluated()) {
+                // пересоздание на месте в констант-вычислениях недоступно
+                alloc_ = alloc;
+                return;
+            }
+        }
+#endif
+        alloc_.~Alloc();
+        ::new (static_cast<void*>(&alloc_)) Alloc(alloc);
+    }
+
+    // Переводит буфер на встроенное хранилище (пустое состояние при InlineCapacity == 0)
+    ADV_VECTOR_CONSTEXPR void ResetToInline() noexcept {
+        if constexpr (kInlineCapacity > 0) {
+            buffer_ = this->Data();
+            capacity_ = kInlineCapacity;
+        }
+    }
+
+    // Выделяет сырую память под n элементов через переданный аллокатор и возвращает указатель на неё
+    ADV_VECTOR_CONSTEXPR T* Allocate(size_t n) {
+#ifdef ADV_VECTOR_STATS
+#if ADV_VECTOR_CONSTEXPR_MODE
+        if (!std::is_constant_evaluated())     // атомарные счётчики недоступны в констант-вычислениях
+#endif
+        {
+            GlobalVectorStats::allocated_bytes += n * sizeof(T);
+        }
+#endif
+        return n != 0 ? std::allocator_traits<Alloc>::allocate(alloc_, n) : nullptr;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        if (buf != nullptr) {
-            operator delete(buf);
+    // Освобождает сырую память, выделенную ранее при помощи Allocate
+    ADV_VECTOR_CONSTEXPR void Deallocate() noexcept {
+        if (buffer_ != nullptr && !IsInline()) {
+            std::allocator_traits<Alloc>::deallocate(alloc_, buffer_, capacity_);
         }
     }
 
+    Alloc alloc_{};                            // прямая инициализация: explicit-конструкторы аллокаторов допустимы
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
-bool operator==(const RawMemory<T>& lhs, const RawMemory<T>& rhs) {
+template <typename T, typename Alloc, size_t N>
+ADV_VECTOR_CONSTEXPR bool operator==(const RawMemory<T, Alloc, N>& lhs, const RawMemory<T, Alloc, N>& rhs) {
     return lhs.Capacity() == rhs.Capacity()
         && lhs.GetAddress() == rhs.GetAddress();
 }
 
-template <typename T>
-bool operator!=(const RawMemory<T>& lhs, const RawMemory<T>& rhs) {
-    return lhs.Capacity() != rhs.Capacity()
-        && lhs.GetAddress() != rhs.GetAddress();
+template <typename T, typename Alloc, size_t N>
+ADV_VECTOR_CONSTEXPR bool operator!=(const RawMemory<T, Alloc, N>& lhs, const RawMemory<T, Alloc, N>& rhs) {
+    return !(lhs == rhs);
 }
 
-template <typename T>
+// Аллокатор с принудительным выравниванием буфера на Align байт.
+// Применяется, когда alignof(T) меньше выравнивания, требуемого SIMD-загрузками:
+// переаллоцированные типы (alignas(64) и т.п.) стандартный аллокатор выравнивает сам
+template <typename T, size_t Align = 64>
+struct AlignedAllocator {
+
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0,
+        "Align must be a power of two not less than alignof(T)");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* buf, size_t /*n*/) noexcept {
+        operator delete(buf, std::align_val_t(Align));
+    }
+};
+
+template <typename T, typename U, size_t Align>
+bool operator==(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) noexcept {
+    return true;
+}
+template <typename T, typename U, size_t Align>
+bool operator!=(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) noexcept {
+    return false;
+}
+
+// Тег конструктора Vector, отключающий инициализацию элементов
+struct UninitializedTag {};
+inline constexpr UninitializedTag kUninitialized{};
+
+// ---------------------------------------- Политики роста ёмкости ---------------------------------
+// Политика должна предоставлять static size_t Grow(size_t current, size_t required),
+// возвращающий новую ёмкость не меньше required при текущей ёмкости current
+
+// Удвоение ёмкости - минимум реаллокаций, но до одного "лишнего" вектора памяти в пике
+struct Growth2x {
+    static constexpr size_t Grow(size_t current, size_t required) {
+        return std::max(required, current * 2);
+    }
+};
+
+// Рост в полтора раза - компромисс между числом реаллокаций и пиковым потреблением памяти
+struct Growth1_5x {
+    static constexpr size_t Grow(size_t current, size_t required) {
+        return std::max(required, current + current / 2 + 1);
+    }
+};
+
+// Рост точно до требуемого размера - минимальное потребление памяти ценой частых реаллокаций
+struct GrowthExact {
+    static constexpr size_t Grow(size_t /*current*/, size_t required) {
+        return required;
+    }
+};
+
+// Заголовок версионированного бинарного формата Vector: за ним в потоке следует
+// один непрерывный блоб из size элементов по element_size байт каждый
+struct VectorBlobHeader {
+    static constexpr uint32_t kMagic = 0x43455641;     // "AVEC" в little-endian
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint64_t size = 0;                                 // число живых элементов в блобе
+    uint64_t element_size = 0;                         // sizeof(T) для контроля совместимости
+};
+
+template <typename T, typename Alloc, size_t InlineCapacity, typename Growth>
+class ConcurrentAppender;
+
+template <typename T, typename Alloc = std::allocator<T>, size_t InlineCapacity = 0,
+    typename Growth = Growth2x>
 class Vector {
+
+    friend class ConcurrentAppender<T, Alloc, InlineCapacity, Growth>;
+
 public:
 
+    using value_type = T;
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
+    using RawMemoryType = RawMemory<T, Alloc, InlineCapacity>;
+    using growth_policy = Growth;
+    static constexpr size_t kInlineCapacity = InlineCapacity;
 
     // ---------------------------------------- Блок конструкторов --------------------------------------
 
     Vector() = default;
 
-    explicit Vector(size_t size)
-        : data_(RawMemory<T>(size)), size_(size) {
+    explicit Vector(const Alloc& alloc)
+        : data_(RawMemoryType(alloc)) {
+    }
+    explicit Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(RawMemoryType(size, alloc)), size_(size) {
 
         std::uninitialized_value_construct_n(data_.GetAddress(), size_);
     }
+    // Создаёт вектор заданного размера, не инициализируя элементы.
+    // Применимо только к тривиальным типам - содержимое должно быть перезаписано вызывающим кодом
+    explicit Vector(size_t size, UninitializedTag, const Alloc& alloc = Alloc())
+        : data_(RawMemoryType(size, alloc)), size_(size) {
+
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+            "Uninitialized mode requires a trivial element type");
+    }
     explicit Vector(const Vector& other)
-        : data_(RawMemory<T>(other.Size())), size_(other.Size()) {
+        : data_(RawMemoryType(other.Size(),
+            std::allocator_traits<Alloc>::select_on_container_copy_construction(other.data_.GetAllocator())))
+        , size_(other.Size()) {
 
         std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
     }
-    Vector(Vector&& other) noexcept
-        : data_(std::move(other.data_)), size_(std::move(other.size_)) {
-
+    // при встроенном буфере перенос поэлементный и noexcept лишь тогда,
+    // когда не бросает релокация самих элементов
+    ADV_VECTOR_CONSTEXPR Vector(Vector&& other) noexcept(InlineCapacity == 0 || kNothrowRelocatable) {
+        if (other.data_.IsInline()) {
+            // содержимое встроенного буфера переносится поэлементно вместе с аллокатором источника
+            data_ = RawMemoryType(other.data_.GetAllocator());
+            RelocateData(other.data_.GetAddress(), other.size_, data_.GetAddress());
+            size_ = other.size_;
+            DestroyRelocated(other.data_.GetAddress(), other.size_);
+        }
+        else {
+            data_ = std::move(other.data_);
+            size_ = other.size_;
+            shared_ = std::move(other.shared_);
+        }
         other.size_ = 0;
     }
     Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
 
+            Detach();                          // запись не должна быть видна живым снимкам
+
             // проверяем текущий капасити
             if (rhs.size_ > data_.Capacity()) {
 
@@ -173,47 +717,63 @@ public:
         }
         return *this;
     }
-    Vector& operator=(Vector&& rhs) noexcept {
+    ADV_VECTOR_CONSTEXPR Vector& operator=(Vector&& rhs) noexcept(InlineCapacity == 0 || kNothrowRelocatable) {
         if (this != &rhs) {
-            data_ = std::move(rhs.data_);
-            size_ = rhs.size_;
+            DestroyOrAbandon();
+            size_ = 0;
+
+            if (rhs.data_.IsInline()) {
+                // содержимое встроенного буфера переносится поэлементно вместе с аллокатором
+                // источника; встроенной ёмкости хватает всегда - InlineCapacity общий
+                data_ = RawMemoryType(rhs.data_.GetAllocator());
+                RelocateData(rhs.data_.GetAddress(), rhs.size_, data_.GetAddress());
+                size_ = rhs.size_;
+                DestroyRelocated(rhs.data_.GetAddress(), rhs.size_);
+            }
+            else {
+                data_ = std::move(rhs.data_);
+                size_ = rhs.size_;
+                shared_ = std::move(rhs.shared_);
+            }
+            rhs.size_ = 0;
         }
         return *this;
     }
 
-    ~Vector() {
-        if (data_.GetAddress() != nullptr) {
-            std::destroy_n(data_.GetAddress(), size_);
-        }
+    ADV_VECTOR_CONSTEXPR ~Vector() {
+        DestroyOrAbandon();
     }
 
     // ---------------------------------------- Блок итераторов доступа ---------------------------------
 
-    iterator begin() noexcept {
+    // неконстантные итераторы позволяют запись, поэтому отвязывают буфер от снимков
+    ADV_VECTOR_CONSTEXPR iterator begin() {
+        Detach();
         return data_.GetAddress();
     }
-    iterator end() noexcept {
+    ADV_VECTOR_CONSTEXPR iterator end() {
+        Detach();
         return data_ + size_;
     }
-    const_iterator begin() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator begin() const noexcept {
         return const_cast<iterator>(data_.GetAddress());
     }
-    const_iterator end() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator end() const noexcept {
         return const_cast<iterator>(data_ + size_);
     }
-    const_iterator cbegin() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator cbegin() const noexcept {
         return begin();
     }
-    const_iterator cend() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator cend() const noexcept {
         return end();
     }
 
     // ---------------------------------------- Блок вставки и удаления значений -----------------------
 
-    void PushBack(const T& value) {
+    ADV_VECTOR_CONSTEXPR void PushBack(const T& value) {
         EmplaceBack(value);                                       // перенаправляем в EmplaceBack
     }
-    void PushBack(T&& value) {
+    ADV_VECTOR_CONSTEXPR void PushBack(T&& value) {
         EmplaceBack(std::move(value));                            // перенаправляем в EmplaceBack
     }
     iterator Insert(const_iterator pos, const T& value) {
@@ -223,142 +783,1152 @@ public:
         return Emplace(pos, std::move(value));                    // перенаправляем в Emplace
     }
 
-    template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
+    // Добавляет копию диапазона [first, last) в конец вектора не более чем с одной реаллокацией
+    template <typename It>
+    void AppendRange(It first, It last) {
 
-        // проверяем наличие свободного места при текущем капасити
-        if (size_ == Capacity()) 
-        {
-            // запускаем релоцирующий EmplaceBack
-            return RelocatedEmplaceBack(std::forward<Args>(args)...);
-        }
-        else 
-        {
-            // запускаем обычный EmplaceBack
-            return UnusedEmplaceBack(std::forward<Args>(args)...);
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
         }
-    }
-    template <typename... Args>
-    iterator Emplace(const_iterator pos, Args&&... args) {
 
-        // проверяем попадание итератора в диапазон данных вектора
-        assert(begin() <= pos && pos <= end());
+        Detach();
 
-        // проверяем наличие свободного места при текущем капасити
-        if (size_ == Capacity())
-        {
-            // запускаем релоцирующий Emplace
-            return RelocatedEmplace(pos, std::forward<Args>(args)...);
-        }
-        else
-        {
-            // запускаем обычный Emplace
-            return UnusedEmplace(pos, std::forward<Args>(args)...);
+        // требуемая ёмкость вычисляется один раз до вставки
+        if (size_ + count > Capacity()) {
+            Reserve(Growth::Grow(Capacity(), size_ + count));
         }
-    }
 
-    void PopBack() {
-        // выполняется при условии того, что в векторе есть хотя бы одно значение
-        if (size_ > 0 && data_.GetAddress() != nullptr) {
-            std::destroy_at(&data_[--size_]);
-        }
+        CopyConstructRange(first, count, data_ + size_);
+        size_ += count;
     }
-    iterator Erase(const_iterator pos) {
-
-        // проверяем попадание итератора в диапазон данных вектора
-        assert(begin() <= pos && pos <= end());
 
-        if (pos == end() - 1) {
-            PopBack();                                              // если pos указывает на конец диапазона то вызываем PopBack();
-            return const_cast<iterator>(end() - 1);
-        }
+    // Заменяет содержимое вектора копией диапазона [first, last) не более чем с одной реаллокацией
+    template <typename It>
+    void Assign(It first, It last) {
 
-        size_t erase_begin_align = pos - begin();                             // выравнивание удаления по началу текуещего массива
+        Detach();
 
-        std::move(begin() + (erase_begin_align + 1), end(), begin() + erase_begin_align);               // перемещаем элементы
-        PopBack();                                                                                      // удаляем крайний элемент
+        const size_t count = static_cast<size_t>(std::distance(first, last));
 
-        return const_cast<iterator>(begin() + erase_begin_align);
+        // если новое содержимое не умещается, то собираем его в новом буфере
+        if (count > Capacity()) {
+            RawMemoryType new_data(count, data_.GetAllocator());
+            CopyConstructRange(first, count, new_data.GetAddress());
 
-    }
+            std::destroy_n(data_.GetAddress(), size_);
+            data_ = std::move(new_data);
+        }
+        else {
 
-    // ---------------------------------------- Блок получения параметров вектора ----------------------
-    
-    size_t Size() const noexcept {
-        return size_;
-    }
-    size_t Capacity() const noexcept {
-        return data_.Capacity();
-    }
-    const RawMemory<T>& Data() const {
-        return data_;
-    }
+            // копируем поверх существующих элементов
+            size_t assigned = std::min(size_, count);
+            for (size_t i = 0; i < assigned; ++i, ++first) {
+                data_[i] = *first;
+            }
 
-    // ---------------------------------------- Блок получения значений элементов вектора --------------
+            // если есть лишнее то удаляем
+            if (count < size_)
+            {
+                std::destroy_n(data_ + count, size_ - count);
+            }
+            // если не хватает то достраиваем недостающее
+            else if (count > size_)
+            {
+                CopyConstructRange(first, count - size_, data_ + size_);
+            }
+        }
 
-    const T& operator[](size_t index) const noexcept {
-        return const_cast<Vector&>(*this)[index];
-    }
-    T& operator[](size_t index) noexcept {
-        assert(index < size_);
-        return data_[index];
+        size_ = count;
     }
 
-    // ---------------------------------------- Блок вспомогательных методов ---------------------------
-
-    void Reserve(size_t new_capacity) {
+    // Вставляет копию диапазона [first, last) перед позицией pos не более чем с одной реаллокацией.
+    // Возвращает итератор на первый вставленный элемент
+    template <typename It>
+    iterator Insert(const_iterator pos, It first, It last) {
 
-        if (new_capacity <= data_.Capacity()) 
-        {
-            // если новый капасити меньше или равен текущему, то ничего не делаем
-            return;
-        }
+        // проверяем попадание итератора в диапазон данных вектора
+        assert(cbegin() <= pos && pos <= cend());
 
-        RawMemory<T> new_data(new_capacity);               // создаем новый объект аллокатора с выделением требуемого места
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        const size_t insert_begin_align = pos - cbegin();                                   // выравнивание вставки по началу текуещего массива
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            // перемещаем все текущие значения в новую область памяти
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        }
-        else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        if (count == 0) {
+            return begin() + insert_begin_align;
         }
 
-        std::destroy_n(data_.GetAddress(), size_);         // разрушаем старый объект памяти и вовзращаем память в кучу
-        data_.Swap(new_data);                       // обмениваем содержимое временного объекта и текущего
-    }
-    void Resize(size_t new_size) {
+        Detach();
 
-        // если новый размер меньше текущего
-        if (new_size < size_)
-        {
-            std::destroy_n(data_ + new_size, size_ - new_size);
-        }
+        if (size_ + count > Capacity()
+            && !data_.TryExtend(Growth::Grow(Capacity(), size_ + count))) {
 
-        // если новый размер больше текущего
-        else
-        {
+            // одна реаллокация: вставляемый диапазон, затем префикс и суффикс старых данных
+            RawMemoryType temp(Growth::Grow(Capacity(), size_ + count), data_.GetAllocator());
+            CopyConstructRange(first, count, temp.GetAddress() + insert_begin_align);
 
-            // если новый размер не укладывается в текущий capacity
-            if (new_size > Capacity())
+            if constexpr (kNothrowRelocatable)
             {
-                Reserve(new_size);
+                // перенос не бросает - быстрый путь без try/catch
+                RelocateData(data_.GetAddress(), insert_begin_align, temp.GetAddress());
+                RelocateData(data_.GetAddress() + insert_begin_align, size_ - insert_begin_align,
+                    temp.GetAddress() + insert_begin_align + count);
             }
+            else
+            {
+                try
+                {
+                    RelocateData(data_.GetAddress(), insert_begin_align, temp.GetAddress());
+                }
+                catch (const std::exception&)
+                {
+                    std::destroy_n(temp.GetAddress() + insert_begin_align, count);          // удаляем вставленный диапазон
+                    throw;                                                                  // выбрасываем исключение дальше
+                }
+                try
+                {
+                    RelocateData(data_.GetAddress() + insert_begin_align, size_ - insert_begin_align,
+                        temp.GetAddress() + insert_begin_align + count);
+                }
+                catch (const std::exception&)
+                {
+                    std::destroy_n(temp.GetAddress(), insert_begin_align + count);          // удаляем префикс вместе со вставленным диапазоном
+                    throw;                                                                  // выбрасываем исключение дальше
+                }
+            }
+            RecordRelocation(size_, temp.Capacity());
+
+            DestroyRelocated(data_.GetAddress(), size_);
+            data_ = std::move(temp);
+        }
+        else {
+
+            const size_t tail_len = size_ - insert_begin_align;                             // длина сдвигаемого хвоста
+
+            if constexpr (is_trivially_relocatable_v<T>) {
+                // хвост сдвигается одним memmove, исходные слоты считаются сырыми
+                std::memmove(static_cast<void*>(data_ + insert_begin_align + count),
+                    static_cast<const void*>(data_ + insert_begin_align), tail_len * sizeof(T));
+                try
+                {
+                    CopyConstructRange(first, count, data_ + insert_begin_align);
+                }
+                catch (const std::exception&)
+                {
+                    // хвост возвращается на место - слоты [pos, size_) снова считаются живыми
+                    std::memmove(static_cast<void*>(data_ + insert_begin_align),
+                        static_cast<const void*>(data_ + insert_begin_align + count), tail_len * sizeof(T));
+                    throw;                                                                  // выбрасываем исключение дальше
+                }
+            }
+            else if (count >= tail_len) {
+                // часть батча за старым концом достраивается первой, затем хвост уезжает
+                // в сырую память, и лишь после этого остаток батча присваивается поверх
+                // перемещённых элементов - до исключения все старые элементы остаются живыми
+                CopyConstructRange(std::next(first, static_cast<std::ptrdiff_t>(tail_len)),
+                    count - tail_len, data_ + size_);
+                try
+                {
+                    RelocateData(data_ + insert_begin_align, tail_len, data_ + insert_begin_align + count);
+                }
+                catch (const std::exception&)
+                {
+                    std::destroy_n(data_ + size_, count - tail_len);                        // удаляем достроенную часть батча
+                    throw;                                                                  // выбрасываем исключение дальше
+                }
+                try
+                {
+                    for (size_t i = 0; i < tail_len; ++i, ++first) {
+                        data_[insert_begin_align + i] = *first;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    std::destroy_n(data_ + size_, count);                                   // удаляем батч вместе с перенесённым хвостом
+                    throw;                                                                  // выбрасываем исключение дальше
+                }
+            }
+            else {
+                // крайние count элементов переезжают в сырую память, остальные сдвигаются присваиванием
+                RelocateData(data_ + (size_ - count), count, data_ + size_);
+                try
+                {
+                    std::move_backward(begin() + insert_begin_align, end() - count, end());
+                    for (size_t i = 0; i < count; ++i, ++first) {
+                        data_[insert_begin_align + i] = *first;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    std::destroy_n(data_ + size_, count);                                   // удаляем перенесённые за конец элементы
+                    throw;                                                                  // выбрасываем исключение дальше
+                }
+            }
+        }
+
+        size_ += count;
+        return begin() + insert_begin_align;
+    }
+
+    // Вливает отсортированный диапазон [first, last) в отсортированный по comp вектор
+    // за один проход справа налево: каждый элемент хвоста переезжает не более одного
+    // раза - O(n + k) вместо O(n * k) у поэлементного Insert. При равенстве ключей
+    // элементы вектора остаются впереди вставляемых. При исключении из копирования
+    // или компаратора вектор остаётся валидным, но частично слитым (базовая гарантия)
+    template <typename It, typename Comp = std::less<T>>
+    void InsertSorted(It first, It last, Comp comp = Comp()) {
+
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+
+        Detach();
+
+        // требуемая ёмкость обеспечивается до слияния
+        if (size_ + count > Capacity()) {
+            Reserve(Growth::Grow(Capacity(), size_ + count));
+        }
+
+        T* base = data_.GetAddress();
+        size_t read = size_;                   // хвост текущих элементов
+        size_t write = size_ + count;          // позиция записи, движется влево
+        It batch_end = last;
+
+        try {
+            while (batch_end != first) {
+                It batch_last = std::prev(batch_end);
+                --write;
+
+                if (read > 0 && comp(*batch_last, base[read - 1])) {
+                    // больший элемент из хвоста вектора уезжает вправо
+                    --read;
+                    if (write >= size_) {
+                        new (base + write) T(std::move(base[read]));    // назначение - сырая память
+                    }
+                    else {
+                        base[write] = std::move(base[read]);
+                    }
+                }
+                else {
+                    // очередной элемент батча встаёт на своё место
+                    if (write >= size_) {
+                        new (base + write) T(*batch_last);
+                    }
+                    else {
+                        base[write] = *batch_last;
+                    }
+                    batch_end = batch_last;
+                }
+            }
+        }
+        catch (const std::exception&) {
+            // достроенный за старым концом суффикс (write, size_ + count) разрушается,
+            // содержимое ниже size_ остаётся валидным - вектор частично слит
+            const size_t constructed_begin = std::max(write + 1, size_);
+            std::destroy_n(base + constructed_begin, size_ + count - constructed_begin);
+            throw;                                                      // выбрасываем исключение дальше
+        }
+
+        size_ += count;
+    }
+
+    template <typename... Args>
+    ADV_VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args) {
+
+        Detach();
+
+        // проверяем наличие свободного места при текущем капасити
+        if (size_ == Capacity())
+        {
+            // сначала пробуем расширить буфер на месте - без переноса элементов
+            if (data_.TryExtend(Growth::Grow(Capacity(), size_ + 1)))
+            {
+                return UnusedEmplaceBack(std::forward<Args>(args)...);
+            }
+
+            // запускаем релоцирующий EmplaceBack
+            return RelocatedEmplaceBack(std::forward<Args>(args)...);
+        }
+        else
+        {
+            // запускаем обычный EmplaceBack
+            return UnusedEmplaceBack(std::forward<Args>(args)...);
+        }
+    }
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+
+        // проверяем попадание итератора в диапазон данных вектора
+        assert(cbegin() <= pos && pos <= cend());
+
+        pos = DetachAt(pos);
+
+        // проверяем наличие свободного места при текущем капасити
+        if (size_ == Capacity())
+        {
+            // сначала пробуем расширить буфер на месте - без переноса элементов
+            if (data_.TryExtend(Growth::Grow(Capacity(), size_ + 1)))
+            {
+                return UnusedEmplace(pos, std::forward<Args>(args)...);
+            }
+
+            // запускаем релоцирующий Emplace
+            return RelocatedEmplace(pos, std::forward<Args>(args)...);
+        }
+        else
+        {
+            // запускаем обычный Emplace
+            return UnusedEmplace(pos, std::forward<Args>(args)...);
+        }
+    }
+
+    ADV_VECTOR_CONSTEXPR void PopBack() {
+        // выполняется при условии того, что в векторе есть хотя бы одно значение
+        if (size_ > 0 && data_.GetAddress() != nullptr) {
+            Detach();
+            std::destroy_at(&data_[--size_]);
+        }
+    }
+    iterator Erase(const_iterator pos) {
+
+        // проверяем попадание итератора в диапазон данных вектора
+        assert(cbegin() <= pos && pos <= cend());
+
+        pos = DetachAt(pos);
+
+        if (pos == end() - 1) {
+            PopBack();                                              // если pos указывает на конец диапазона то вызываем PopBack();
+            return const_cast<iterator>(end() - 1);
+        }
+
+        size_t erase_begin_align = pos - begin();                             // выравнивание удаления по началу текуещего массива
+
+        std::move(begin() + (erase_begin_align + 1), end(), begin() + erase_begin_align);               // перемещаем элементы
+        PopBack();                                                                                      // удаляем крайний элемент
+
+        return const_cast<iterator>(begin() + erase_begin_align);
+
+    }
+    // Удаляет диапазон [first, last), сдвигая хвост ровно один раз.
+    // Возвращает итератор на элемент, следующий за удалённым диапазоном
+    iterator Erase(const_iterator first, const_iterator last) {
+
+        // проверяем попадание диапазона в данные вектора
+        assert(cbegin() <= first && first <= last && last <= cend());
+
+        const size_t erase_begin_align = first - cbegin();                    // выравнивание удаления по началу текуещего массива
+        const size_t count = last - first;
+
+        if (count == 0) {
+            return begin() + erase_begin_align;
+        }
+
+        Detach();
+
+        std::move(begin() + erase_begin_align + count, end(), begin() + erase_begin_align);   // перемещаем хвост одним проходом
+        std::destroy_n(data_ + (size_ - count), count);                                       // разрушаем освободившиеся крайние элементы
+        size_ -= count;
+
+        return begin() + erase_begin_align;
+    }
+    // Удаляет все элементы, удовлетворяющие предикату, за один проход (remove-erase внутри).
+    // Возвращает количество удалённых элементов
+    template <typename Pred>
+    size_t EraseIf(Pred pred) {
+
+        iterator new_end = std::remove_if(begin(), end(), pred);
+        const size_t removed = end() - new_end;
+
+        std::destroy_n(new_end, removed);
+        size_ -= removed;
+
+        return removed;
+    }
+    // Удаляет элемент за O(1), перемещая на его место крайний - порядок элементов не сохраняется.
+    // Возвращает итератор на элемент, занявший освободившуюся позицию
+    iterator UnorderedErase(const_iterator pos) {
+
+        // проверяем попадание итератора в диапазон данных вектора
+        assert(cbegin() <= pos && pos < cend());
+
+        Detach();
+
+        const size_t erase_begin_align = pos - cbegin();
+
+        if (erase_begin_align != size_ - 1) {
+            data_[erase_begin_align] = std::move(data_[size_ - 1]);           // крайний элемент занимает место удаляемого
+        }
+        PopBack();                                                            // удаляем крайний элемент
+
+        return begin() + erase_begin_align;
+    }
+
+    // ---------------------------------------- Блок получения параметров вектора ----------------------
+    
+    ADV_VECTOR_CONSTEXPR size_t Size() const noexcept {
+        return size_;
+    }
+    ADV_VECTOR_CONSTEXPR size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    // Владеющее описание буфера, отсоединённого от вектора
+    struct ReleasedBuffer {
+        T* buffer = nullptr;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
+    // Отдаёт буфер вместе с владением и оставляет вектор пустым - O(1), без копирования.
+    // Получатель отвечает за разрушение живых элементов и возврат памяти (например,
+    // через Vector::Adopt). Для SBO-векторов недоступно: встроенный буфер неотчуждаем
+    ReleasedBuffer ReleaseBuffer() {
+
+        static_assert(kInlineCapacity == 0, "ReleaseBuffer is not available for SBO vectors");
+
+        Detach();                              // буфер с живыми снимками неотчуждаем - сначала копия
+
+        ReleasedBuffer released{ nullptr, size_, data_.Capacity() };
+        released.buffer = data_.Release();
+        size_ = 0;
+        return released;
+    }
+
+    // Принимает владение буфером, совместимым с Deallocate используемого аллокатора -
+    // например, полученным ранее через ReleaseBuffer. O(1), без копирования
+    static Vector Adopt(T* buf, size_t size, size_t capacity, const Alloc& alloc = Alloc()) {
+
+        static_assert(kInlineCapacity == 0, "Adopt is not available for SBO vectors");
+        assert(size <= capacity);
+
+        Vector adopted;
+        adopted.data_ = RawMemoryType(buf, capacity, alloc);
+        adopted.size_ = size;
+        return adopted;
+    }
+
+#ifdef ADV_VECTOR_STATS
+    // Счётчики данного экземпляра; глобальный агрегат доступен через GlobalVectorStats
+    const VectorStats& Stats() const noexcept {
+        return stats_;
+    }
+#endif
+
+    // Отчёт о памяти вектора: сколько байт выделено и сколько занято живыми элементами
+    struct MemoryStats {
+        size_t allocated_bytes = 0;
+        size_t live_bytes = 0;
+    };
+    MemoryStats MemoryFootprint() const noexcept {
+        return { Capacity() * sizeof(T), Size() * sizeof(T) };
+    }
+    const RawMemoryType& Data() const {
+        return data_;
+    }
+
+    // ---------------------------------------- Блок снимков (copy-on-write) ---------------------------
+
+    // Снимок вектора: дешёвое read-only представление содержимого, разделяющее буфер
+    // с вектором-источником. Копируется за O(1) и живёт независимо от вектора
+    class SnapshotView {
+        friend class Vector;
+    public:
+
+        SnapshotView() = default;
+
+        const T* begin() const noexcept {
+            return state_.Get() != nullptr ? state_->memory.GetAddress() : nullptr;
+        }
+        const T* end() const noexcept {
+            return begin() + Size();
+        }
+        size_t Size() const noexcept {
+            return state_.Get() != nullptr ? state_->size : 0;
+        }
+        const T& operator[](size_t index) const noexcept {
+            assert(state_.Get() != nullptr && index < state_->size);
+            return state_->memory.GetAddress()[index];
+        }
+
+    private:
+        // Общий блок владения: буфер жив, пока жив вектор-владелец или хотя бы один снимок
+        struct State {
+            RawMemoryType memory;
+            size_t size = 0;
+            std::atomic<size_t> refs{ 1 };     // владельцы блока: вектор и все живые снимки
+
+            State(RawMemoryType&& memory, size_t size)
+                : memory(std::move(memory)), size(size) {
+            }
+            ~State() {
+                if (memory.GetAddress() != nullptr) {
+                    std::destroy_n(memory.GetAddress(), size);
+                }
+            }
+        };
+
+        // Минимальный разделяемый владелец State со счётчиком ссылок. Заменяет
+        // shared_ptr, чтобы Vector оставался литеральным типом для constexpr-режима:
+        // у пустого хэндла весь жизненный цикл пригоден для констант-вычислений
+        class StateHandle {
+        public:
+
+            constexpr StateHandle() noexcept = default;
+
+            // принимает владение готовым блоком со счётчиком, уже равным единице
+            explicit StateHandle(State* state) noexcept
+                : state_(state) {
+            }
+            StateHandle(const StateHandle& other) noexcept
+                : state_(other.state_) {
+                if (state_ != nullptr) {
+                    state_->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            ADV_VECTOR_CONSTEXPR StateHandle(StateHandle&& other) noexcept
+                : state_(other.state_) {
+                other.state_ = nullptr;
+            }
+            StateHandle& operator=(const StateHandle& rhs) noexcept {
+                if (this != &rhs) {
+                    Reset();
+                    state_ = rhs.state_;
+                    if (state_ != nullptr) {
+                        state_->refs.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                return *this;
+            }
+            ADV_VECTOR_CONSTEXPR StateHandle& operator=(StateHandle&& rhs) noexcept {
+                if (this != &rhs) {
+                    Reset();
+                    state_ = rhs.state_;
+                    rhs.state_ = nullptr;
+                }
+                return *this;
+            }
+            ADV_VECTOR_CONSTEXPR ~StateHandle() {
+                Reset();
+            }
+
+            // Отпускает ссылку; крайний владелец разрушает общий блок
+            ADV_VECTOR_CONSTEXPR void Reset() noexcept {
+                if (state_ != nullptr) {
+                    if (state_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        delete state_;
+                    }
+                    state_ = nullptr;
+                }
+            }
+
+            constexpr State* Get() const noexcept {
+                return state_;
+            }
+            State* operator->() const noexcept {
+                return state_;
+            }
+            size_t UseCount() const noexcept {
+                return state_ != nullptr ? state_->refs.load(std::memory_order_relaxed) : 0;
+            }
+
+        private:
+            State* state_ = nullptr;
+        };
+
+        explicit SnapshotView(StateHandle state) noexcept
+            : state_(std::move(state)) {
+        }
+
+        StateHandle state_;
+    };
+
+    // Возвращает снимок текущего содержимого за O(1), без копирования элементов.
+    // Буфер становится общим: первая же мутация вектора при живых снимках скопирует
+    // содержимое в собственный буфер (copy-on-write), сами снимки неизменяемы.
+    // Для SBO-векторов недоступно: встроенный буфер неразделяем
+    SnapshotView Snapshot() {
+
+        static_assert(kInlineCapacity == 0, "Snapshot is not available for SBO vectors");
+        static_assert(std::is_copy_constructible_v<T>,
+            "Snapshot requires a copy-constructible element type");
+
+        if (shared_.Get() == nullptr) {
+            const size_t capacity = data_.Capacity();
+            shared_ = typename SnapshotView::StateHandle(
+                new typename SnapshotView::State(std::move(data_), size_));
+
+            // вектор продолжает читать тот же буфер как невладеющий псевдоним -
+            // реальное владение возвращает или замещает Detach()
+            data_ = RawMemoryType(shared_->memory.GetAddress(), capacity, shared_->memory.GetAllocator());
+        }
+        return SnapshotView(shared_);
+    }
+
+    // ---------------------------------------- Блок получения значений элементов вектора --------------
+
+    ADV_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+    ADV_VECTOR_CONSTEXPR T& operator[](size_t index) {
+        assert(index < size_);
+        Detach();                              // запись по ссылке не должна быть видна снимкам
+        return data_[index];
+    }
+
+    // Доступ с обязательной проверкой диапазона: в отличие от assert в operator[]
+    // проверка не исчезает в release-сборке. Бросает std::out_of_range
+    const T& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Vector::At: index is out of range");
+        }
+        return data_[index];
+    }
+    T& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Vector::At: index is out of range");
+        }
+        Detach();                              // запись по ссылке не должна быть видна снимкам
+        return data_[index];
+    }
+
+    // Невладеющий срез непрерывного буфера для горячих циклов: указатель несёт
+    // __restrict - компилятор считает, что через срез не алиасится никакая другая
+    // память, и векторизует внутренний цикл без проверок пересечения и диапазона.
+    // Срез действителен до следующей мутации или реаллокации вектора
+    struct UncheckedSpan {
+        T* __restrict data = nullptr;
+        size_t size = 0;
+
+        T* begin() const noexcept {
+            return data;
+        }
+        T* end() const noexcept {
+            return data + size;
+        }
+        T& operator[](size_t index) const noexcept {
+            return data[index];
+        }
+        size_t Size() const noexcept {
+            return size;
+        }
+    };
+    struct ConstUncheckedSpan {
+        const T* __restrict data = nullptr;
+        size_t size = 0;
+
+        const T* begin() const noexcept {
+            return data;
+        }
+        const T* end() const noexcept {
+            return data + size;
+        }
+        const T& operator[](size_t index) const noexcept {
+            return data[index];
+        }
+        size_t Size() const noexcept {
+            return size;
+        }
+    };
+
+    // Срез всего содержимого; неконстантная версия допускает запись и потому
+    // отвязывает буфер от живых снимков
+    UncheckedSpan Span() {
+        Detach();
+        return { data_.GetAddress(), size_ };
+    }
+    ConstUncheckedSpan Span() const {
+        return { data_.GetAddress(), size_ };
+    }
+
+    // ---------------------------------------- Блок поиска значений -----------------------------------
+
+    // Возвращает итератор на первое вхождение value или end(), если его нет.
+    // Для тривиально-сравнимых типов сравнение идёт векторизуемым ядром FindValue
+    const_iterator Find(const T& value) const {
+        return FindValue(data_.GetAddress(), data_.GetAddress() + size_, value);
+    }
+    iterator Find(const T& value) {
+        Detach();                              // возвращаемый итератор допускает запись
+        return const_cast<iterator>(
+            FindValue(data_.GetAddress(), data_.GetAddress() + size_, value));
+    }
+    // Сообщает, содержится ли value в векторе
+    bool Contains(const T& value) const {
+        return Find(value) != end();
+    }
+
+    // ---------------------------------------- Блок бинарной сериализации -----------------------------
+
+    // Пишет содержимое одним заголовком и одним непрерывным блобом живых элементов.
+    // writer - вызываемое writer(const void* data, size_t bytes); при записи в файловый
+    // дескриптор блоб уходит одним системным вызовом. Только для тривиально-копируемых T
+    template <typename Writer>
+    void SerializeTo(Writer&& writer) const {
+
+        static_assert(std::is_trivially_copyable_v<T>,
+            "Binary serialization requires a trivially copyable element type");
+
+        VectorBlobHeader header;
+        header.size = size_;
+        header.element_size = sizeof(T);
+
+        writer(static_cast<const void*>(&header), sizeof(header));
+        if (size_ != 0) {
+            writer(static_cast<const void*>(data_.GetAddress()), size_ * sizeof(T));
+        }
+    }
+
+    // Восстанавливает вектор из непрерывного буфера с сериализованным представлением:
+    // проверка заголовка и один memcpy блоба, без поэлементной работы.
+    // Бросает std::runtime_error при несовместимом или усечённом формате
+    static Vector DeserializeFrom(const void* buffer, size_t bytes, const Alloc& alloc = Alloc()) {
+
+        static_assert(std::is_trivially_copyable_v<T>,
+            "Binary serialization requires a trivially copyable element type");
+
+        VectorBlobHeader header;
+        if (buffer == nullptr || bytes < sizeof(header)) {
+            throw std::runtime_error("Vector blob is truncated");
+        }
+        std::memcpy(&header, buffer, sizeof(header));
+
+        if (header.magic != VectorBlobHeader::kMagic || header.version != VectorBlobHeader::kVersion) {
+            throw std::runtime_error("Vector blob has an unknown format or version");
+        }
+        if (header.element_size != sizeof(T)
+            || bytes - sizeof(header) < header.size * sizeof(T)) {
+            throw std::runtime_error("Vector blob does not match the element type");
+        }
+
+        const size_t count = static_cast<size_t>(header.size);
+
+        Vector restored{ alloc };
+        restored.data_ = RawMemoryType(count, alloc);
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(restored.data_.GetAddress()),
+                static_cast<const char*>(buffer) + sizeof(header), count * sizeof(T));
+        }
+        restored.size_ = count;
+        return restored;
+    }
+
+    // ---------------------------------------- Блок поэлементных операций -----------------------------
+
+    // Применяет fn к каждому элементу
+    template <typename Fn>
+    void ForEach(Fn fn) {
+        Detach();                              // fn получает неконстантные ссылки
+        T* base = data_.GetAddress();
+        for (size_t i = 0; i < size_; ++i) {
+            fn(base[i]);
+        }
+    }
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        const T* base = data_.GetAddress();
+        for (size_t i = 0; i < size_; ++i) {
+            fn(base[i]);
+        }
+    }
+    // Параллельная версия ForEach: куски буфера разбираются thread_count потоками через
+    // общий счётчик (0 - аппаратный параллелизм). fn не должна бросать исключений
+    // и не должна обращаться к чужим элементам
+    template <typename Fn>
+    void ForEach(Fn fn, size_t thread_count) {
+        Detach();
+        T* base = data_.GetAddress();
+        ParallelClaimChunks(size_, thread_count, [base, &fn](size_t offset, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(base[offset + i]);
+            }
+        });
+    }
+    template <typename Fn>
+    void ForEach(Fn fn, size_t thread_count) const {
+        const T* base = data_.GetAddress();
+        ParallelClaimChunks(size_, thread_count, [base, &fn](size_t offset, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(base[offset + i]);
+            }
+        });
+    }
+
+    // Обход с программной предвыборкой для элементов с косвенностью: аппаратный
+    // префетчер покрывает сам буфер, но не память за указателями внутри элементов.
+    // project(элемент) возвращает адрес, который понадобится fn, - он запрашивается
+    // в кэш за distance элементов до обработки, и разыменование в fn не ждёт память.
+    // Дистанцию подбирают по профилю; типичный диапазон - 4..16 элементов
+    template <typename Project, typename Fn>
+    void ScanWithPrefetch(size_t distance, Project project, Fn fn) {
+        Detach();                              // fn получает неконстантные ссылки
+        T* base = data_.GetAddress();
+        for (size_t i = 0; i < size_; ++i) {
+            if (i + distance < size_) {
+                PrefetchRead(project(base[i + distance]));
+            }
+            fn(base[i]);
+        }
+    }
+    template <typename Project, typename Fn>
+    void ScanWithPrefetch(size_t distance, Project project, Fn fn) const {
+        const T* base = data_.GetAddress();
+        for (size_t i = 0; i < size_; ++i) {
+            if (i + distance < size_) {
+                PrefetchRead(project(base[i + distance]));
+            }
+            fn(base[i]);
+        }
+    }
+
+    // Заменяет каждый элемент результатом fn(элемент)
+    template <typename Fn>
+    void Transform(Fn fn) {
+        Detach();
+        T* base = data_.GetAddress();
+        for (size_t i = 0; i < size_; ++i) {
+            base[i] = fn(std::move(base[i]));
+        }
+    }
+    // Параллельная версия Transform; требования к fn - как у параллельного ForEach
+    template <typename Fn>
+    void Transform(Fn fn, size_t thread_count) {
+        Detach();
+        T* base = data_.GetAddress();
+        ParallelClaimChunks(size_, thread_count, [base, &fn](size_t offset, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                base[offset + i] = fn(std::move(base[offset + i]));
+            }
+        });
+    }
+
+    // Свёртка элементов: последовательно накапливает init через op(аккумулятор, элемент)
+    template <typename U, typename BinOp>
+    U Reduce(U init, BinOp op) const {
+        const T* base = data_.GetAddress();
+        for (size_t i = 0; i < size_; ++i) {
+            init = op(std::move(init), base[i]);
+        }
+        return init;
+    }
+    // Параллельная свёртка: каждый поток накапливает частичную сумму по разобранным кускам,
+    // частичные суммы сводятся тем же op. Требования как у std::reduce: op ассоциативна,
+    // коммутативна, не бросает исключений, init - нейтральный элемент op
+    template <typename U, typename BinOp>
+    U Reduce(U init, BinOp op, size_t thread_count) const {
+
+        U result = init;
+        std::mutex merge_mutex;
+        const T* base = data_.GetAddress();
+
+        ParallelClaimChunks(size_, thread_count,
+            [base, init, &op, &result, &merge_mutex](size_t offset, size_t count) {
+
+            U partial = init;                  // init нейтрален - частичные суммы независимы
+            for (size_t i = 0; i < count; ++i) {
+                partial = op(std::move(partial), base[offset + i]);
+            }
+
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            result = op(std::move(result), std::move(partial));
+        });
+
+        return result;
+    }
+
+    // ---------------------------------------- Блок вспомогательных методов ---------------------------
+
+    ADV_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+
+        if (new_capacity <= data_.Capacity())
+        {
+            // если новый капасити меньше или равен текущему, то ничего не делаем
+            return;
+        }
+
+        Detach();
+
+        if (data_.TryExtend(new_capacity))
+        {
+            // аллокатор расширил буфер на месте - перенос элементов не нужен
+            return;
+        }
+
+        RawMemoryType new_data(new_capacity, data_.GetAllocator());// создаем новый объект аллокатора с выделением требуемого места
+
+        // переносим все текущие значения в новую область памяти
+        RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
+        RecordRelocation(size_, new_capacity);
+
+        DestroyRelocated(data_.GetAddress(), size_);       // разрушаем старый объект памяти и вовзращаем память в кучу
+        data_ = std::move(new_data);                // забираем новый буфер (старый мог быть встроенным)
+    }
+    ADV_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+
+        Detach();
+
+        // если новый размер меньше текущего
+        if (new_size < size_)
+        {
+            std::destroy_n(data_ + new_size, size_ - new_size);
+        }
+
+        // если новый размер больше текущего
+        else
+        {
+
+            // если новый размер не укладывается в текущий capacity
+            if (new_size > Capacity())
+            {
+                Reserve(new_size);
+            }
+
+            // инициализируем новые поля вектора стандартным конструктором типа <T>
+#if ADV_VECTOR_CONSTEXPR_MODE
+            if (std::is_constant_evaluated()) {
+                for (size_t i = size_; i < new_size; ++i) {
+                    std::construct_at(data_ + i);
+                }
+            }
+            else
+#endif
+            {
+                std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
+            }
+        }
+        
+        size_ = new_size;                    // обновляем запись о размере вектора
+    }
+    // Параллельная версия Reserve: перенос элементов в новый буфер разрезается между
+    // thread_count потоками (0 - аппаратный параллелизм). Перенос распараллеливается только
+    // для тривиально-копируемых и nothrow-перемещаемых типов, иначе выполняется в один поток
+    void Reserve(size_t new_capacity, size_t thread_count) {
+
+        if (new_capacity <= data_.Capacity())
+        {
+            return;
+        }
+
+        Detach();
+
+        if (data_.TryExtend(new_capacity))
+        {
+            return;
+        }
+
+        RawMemoryType new_data(new_capacity, data_.GetAllocator());
+
+        if constexpr (std::is_trivially_copyable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+            T* from = data_.GetAddress();
+            T* to = new_data.GetAddress();
+            ParallelChunks(size_, thread_count, [from, to](size_t offset, size_t count) {
+                RelocateData(from + offset, count, to + offset);
+            });
+        }
+        else {
+            RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
+        }
+        RecordRelocation(size_, new_capacity);
+
+        DestroyRelocated(data_.GetAddress(), size_);
+        data_ = std::move(new_data);
+    }
+
+    // Параллельная версия Resize: достройка и разрушение элементов разрезаются между
+    // thread_count потоками (0 - аппаратный параллелизм). Конструктор и деструктор T
+    // не должны бросать исключений - куски выполняются независимо
+    void Resize(size_t new_size, size_t thread_count) {
+
+        static_assert(std::is_nothrow_default_constructible_v<T>,
+            "Parallel Resize requires a nothrow default constructor");
+
+        Detach();
+
+        // если новый размер меньше текущего
+        if (new_size < size_)
+        {
+            T* base = data_.GetAddress();
+            ParallelChunks(size_ - new_size, thread_count, [base, new_size](size_t offset, size_t count) {
+                std::destroy_n(base + new_size + offset, count);
+            });
+        }
+
+        // если новый размер больше текущего
+        else
+        {
+            if (new_size > Capacity())
+            {
+                Reserve(new_size, thread_count);
+            }
+
+            T* base = data_.GetAddress();
+            const size_t old_size = size_;
+            ParallelChunks(new_size - old_size, thread_count, [base, old_size](size_t offset, size_t count) {
+                std::uninitialized_value_construct_n(base + old_size + offset, count);
+            });
+        }
+
+        size_ = new_size;                    // обновляем запись о размере вектора
+    }
+
+    // Возвращает неиспользуемую ёмкость в кучу, пересаживая элементы в буфер точно по размеру.
+    // Для SBO-вектора с размером, умещающимся во встроенный буфер, возвращает данные в него
+    void ShrinkToFit() {
+
+        Detach();
+
+        if (data_.IsInline() || Capacity() == size_)
+        {
+            // встроенный буфер не занимает кучу, точная ёмкость не требует действий
+            return;
+        }
+
+        if constexpr (kInlineCapacity > 0) {
+            if (size_ <= kInlineCapacity) {
+                data_.MoveToInline(size_);
+                return;
+            }
+        }
+
+        RawMemoryType new_data(size_, data_.GetAllocator());        // создаем буфер ровно под текущий размер
+
+        // переносим все текущие значения в новую область памяти
+        RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
+
+        DestroyRelocated(data_.GetAddress(), size_);                // разрушаем старый объект памяти и возвращаем память в кучу
+        data_ = std::move(new_data);                                // забираем новый буфер
+    }
+    // Изменяет размер, не инициализируя новые элементы - для буферов ввода-вывода,
+    // содержимое которых будет полностью перезаписано (чтение из сокета/файла).
+    // Применимо только к тривиальным типам
+    void ResizeUninitialized(size_t new_size) {
+
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+            "Uninitialized mode requires a trivial element type");
+
+        Detach();
+
+        // если новый размер не укладывается в текущий capacity
+        if (new_size > Capacity())
+        {
+            Reserve(new_size);
+        }
+
+        size_ = new_size;                    // обновляем запись о размере вектора
+    }
+    void Swap(Vector& other) noexcept {
+        if constexpr (kInlineCapacity == 0) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+            std::swap(shared_, other.shared_);
+        }
+        else {
+            if (!data_.IsInline() && !other.data_.IsInline()) {
+                // оба буфера в куче - достаточно обменяться указателями
+                data_.Swap(other.data_);
+                std::swap(size_, other.size_);
+                std::swap(shared_, other.shared_);
+            }
+            else {
+                // хотя бы один буфер встроенный - обмен через перемещение элементов
+                Vector temp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(temp);
+            }
+        }
+    }
 
-            // инициализируем новые поля вектора стандартным конструктором типа <T>
-            std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
-        }
-        
-        size_ = new_size;                    // обновляем запись о размере вектора
-    }
-    void Swap(Vector& other) noexcept {
-        data_.Swap(other.data_);
-        std::swap(size_, other.size_);
-    }
-
 private:
-    RawMemory<T> data_ = {};
+    RawMemoryType data_ = {};
     size_t size_ = 0;
+    typename SnapshotView::StateHandle shared_;              // общий блок владения при живых снимках
+
+#ifdef ADV_VECTOR_STATS
+    VectorStats stats_ = {};
+#endif
+
+    // Сбрасывает владение текущим буфером: при живых снимках буфер остаётся у них,
+    // иначе элементы разрушаются обычным способом
+    ADV_VECTOR_CONSTEXPR void DestroyOrAbandon() noexcept {
+        if (shared_.Get() != nullptr) {
+            (void)data_.Release();                         // буфером владеет общий блок
+            shared_.Reset();
+        }
+        else if (data_.GetAddress() != nullptr) {
+            std::destroy_n(data_.GetAddress(), size_);
+        }
+    }
+
+    // Отвязывает буфер от снимков перед мутацией: если снимков не осталось - возвращает
+    // владение вектору за O(1), иначе собирает собственную копию элементов (copy-on-write)
+    ADV_VECTOR_CONSTEXPR void Detach() {
+        if (shared_.Get() == nullptr) {
+            return;
+        }
+
+        if (shared_.UseCount() == 1) {
+            // все снимки умерли - владение возвращается вектору без копирования
+            (void)data_.Release();
+            data_ = std::move(shared_->memory);
+            shared_.Reset();
+            return;
+        }
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            RawMemoryType new_data(data_.Capacity(), data_.GetAllocator());
+            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+
+            (void)data_.Release();                         // буфером продолжают владеть снимки
+            data_ = std::move(new_data);
+            shared_.Reset();
+        }
+    }
+
+    // Вариант Detach для мутаторов, принимающих итератор: перепривязывает pos к новому буферу
+    const_iterator DetachAt(const_iterator pos) {
+        if (shared_.Get() != nullptr) {
+            const size_t offset = pos - cbegin();
+            Detach();
+            pos = cbegin() + offset;
+        }
+        return pos;
+    }
+
+    // Регистрирует переезд буфера в счётчиках; при сборке без ADV_VECTOR_STATS не генерирует кода
+    ADV_VECTOR_CONSTEXPR void RecordRelocation(size_t relocated, size_t new_capacity) noexcept {
+#ifdef ADV_VECTOR_STATS
+#if ADV_VECTOR_CONSTEXPR_MODE
+        if (std::is_constant_evaluated()) {
+            return;                            // атомарные счётчики недоступны в констант-вычислениях
+        }
+#endif
+        ++stats_.reallocations;
+        stats_.relocated_elements += relocated;
+        stats_.peak_capacity = std::max(stats_.peak_capacity, new_capacity);
+        stats_.allocated_bytes += new_capacity * sizeof(T);
+
+        ++GlobalVectorStats::reallocations;
+        GlobalVectorStats::relocated_elements += relocated;
+#else
+        (void)relocated;
+        (void)new_capacity;
+#endif
+    }
+
+    // Конструирует count элементов из диапазона с началом в first в сырой памяти dst.
+    // Для тривиально-копируемых типов и итераторов-указателей сводится к одному memcpy
+    template <typename It>
+    static void CopyConstructRange(It first, size_t count, T* dst) {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<It>
+            && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), count * sizeof(T));
+            }
+        }
+        else {
+            std::uninitialized_copy_n(first, count, dst);
+        }
+    }
 
     // Вставка элемента по указанной позиции в вектор без релокации памяти
     template <typename... Args>
@@ -390,6 +1960,13 @@ private:
         return const_cast<iterator>(data_ + insert_begin_align);
 
     }
+    // Перенос элементов в новый буфер заведомо не бросает: memcpy-релокация или
+    // nothrow-перемещение. Для таких типов релоцирующие вставки идут по быстрому
+    // пути без каркаса try/catch - оптимизатор сшивает конструирование и перенос
+    // в прямолинейный код
+    static constexpr bool kNothrowRelocatable =
+        is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
     // Вставка элемента по указанной позиции в вектор с релокацией памяти
     template <typename... Args>
     iterator RelocatedEmplace(const_iterator pos, Args&&... args) {
@@ -403,35 +1980,37 @@ private:
         size_t insert_begin_align = pos - begin();                                          // выравнивание вставки по началу текуещего массива
         size_t insert_back_align = end() - pos;                                             // выравнивание вставки по окончанию текущего массива
 
-        RawMemory<T> temp((size_ == 0 ? 1 : size_ * 2));                                    // создаём временный вектор того же капасити 
+        RawMemoryType temp(Growth::Grow(Capacity(), size_ + 1), data_.GetAllocator());                                    // создаём временный буфер с ёмкостью по политике роста
         new (temp.GetAddress() + insert_begin_align) T(std::forward<Args>(args)...);        // размещаем в нем переданный элемент args(value)
 
-        try
+        if constexpr (kNothrowRelocatable)
         {
-            // размещаем данные в два этапа сначала то что до позиции pos, потом то, что после
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-
+            // перенос не бросает - быстрый путь без try/catch
+            RelocateData(data_.GetAddress(), insert_begin_align, temp.GetAddress());
+            RelocateData(data_.GetAddress() + insert_begin_align, insert_back_align, temp.GetAddress() + (insert_begin_align + 1));
+        }
+        else
+        {
+            try
+            {
+                // размещаем данные в два этапа сначала то что до позиции pos, потом то, что после
                 // источник данных - начало текущего вектора, количество - выравнивание по началу, приемщик - начало временного вектора
-                std::uninitialized_move_n(data_.GetAddress(), insert_begin_align, temp.GetAddress());
+                RelocateData(data_.GetAddress(), insert_begin_align, temp.GetAddress());
 
-                // источник данных - начало текущего вектора + начальное выравнивание, 
+                // источник данных - начало текущего вектора + начальное выравнивание,
                 // количество - выравнивание по окончанию, приемщик - начало временного вектора + выравнивание + 1
-                std::uninitialized_move_n(data_.GetAddress() + insert_begin_align, insert_back_align, temp.GetAddress() + (insert_begin_align + 1));
+                RelocateData(data_.GetAddress() + insert_begin_align, insert_back_align, temp.GetAddress() + (insert_begin_align + 1));
             }
-            else {
-                // аналогично move-версии
-                std::uninitialized_copy_n(data_.GetAddress(), insert_begin_align, temp.GetAddress());
-                std::uninitialized_copy_n(data_.GetAddress() + insert_begin_align, insert_back_align, temp.GetAddress() + (insert_begin_align + 1));
+            catch (const std::exception&)
+            {
+                std::destroy_n(temp.GetAddress(), size_ + 1);                               // удаляем созданный буфер
+                throw;                                                                      // выбрасываем исключение дальше
             }
         }
-        catch (const std::exception&)
-        {
-            std::destroy_n(temp.GetAddress(), size_ + 1);                                   // удаляем созданный буфер
-            throw;                                                                          // выбрасываем исключение дальше
-        }
 
-        std::destroy_n(data_.GetAddress(), size_);                                          // удаляем старые данные
-        data_.Swap(temp);                                                            // свапаем новые данные
+        RecordRelocation(size_, temp.Capacity());
+        DestroyRelocated(data_.GetAddress(), size_);                                        // удаляем старые данные
+        data_ = std::move(temp);                                                     // забираем новый буфер
         ++size_;                                                                            // увеличиваем количество элементов
 
         // возвращаем итератор на вставленный элемент
@@ -440,36 +2019,40 @@ private:
 
     // Вставка элемента в конец вектора без релокации памяти
     template <typename... Args>
-    T& UnusedEmplaceBack(Args&&... args) 
+    ADV_VECTOR_CONSTEXPR T& UnusedEmplaceBack(Args&&... args)
     {
-        new (data_ + size_) T(std::forward<Args>(args)...);                                 // добавляем новый элемент в конец
+        ConstructAt(data_ + size_, std::forward<Args>(args)...);                            // добавляем новый элемент в конец
         return data_[size_++];                                                              // возвращаем ссылку на него и увеличиваем размер
     }
     // Вставка элемента в конец вектора с релокацией памяти
     template <typename... Args>
-    T& RelocatedEmplaceBack(Args&&... args) {
+    ADV_VECTOR_CONSTEXPR T& RelocatedEmplaceBack(Args&&... args) {
 
-        RawMemory<T> temp((size_ == 0 ? 1 : size_ * 2));                                    // создаем буфер с требуемой капасити
-        new (temp.GetAddress() + size_) T(std::forward<Args>(args)...);                     // записываем в конец полученное значение args(value)
+        RawMemoryType temp(Growth::Grow(Capacity(), size_ + 1), data_.GetAllocator());                                    // создаем буфер с ёмкостью по политике роста
+        ConstructAt(temp.GetAddress() + size_, std::forward<Args>(args)...);                // записываем в конец полученное значение args(value)
 
-        try
+        if constexpr (kNothrowRelocatable)
         {
-            // создаём увеличенную копию существующих данных
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(data_.GetAddress(), size_, temp.GetAddress());
-            }
-            else {
-                std::uninitialized_copy_n(data_.GetAddress(), size_, temp.GetAddress());
-            }
+            // перенос не бросает - быстрый путь без try/catch
+            RelocateData(data_.GetAddress(), size_, temp.GetAddress());
         }
-        catch (const std::exception&)
+        else
         {
-            std::destroy_n(temp.GetAddress(), size_ + 1);                                   // удаляем созданный буфер
-            throw;                                                                          // выбрасываем исключение дальше
+            try
+            {
+                // создаём увеличенную копию существующих данных
+                RelocateData(data_.GetAddress(), size_, temp.GetAddress());
+            }
+            catch (const std::exception&)
+            {
+                std::destroy_n(temp.GetAddress(), size_ + 1);                               // удаляем созданный буфер
+                throw;                                                                      // выбрасываем исключение дальше
+            }
         }
 
-        std::destroy_n(data_.GetAddress(), size_);                                          // удаляем старые данные
-        data_.Swap(temp);                                                            // свапаем новые данные
+        RecordRelocation(size_, temp.Capacity());
+        DestroyRelocated(data_.GetAddress(), size_);                                        // удаляем старые данные
+        data_ = std::move(temp);                                                     // забираем новый буфер
         ++size_;                                                                            // увеличиваем количество элементов
 
         // возвращаем значение крайнего элемента
@@ -478,14 +2061,110 @@ private:
 
 };
 
+// Вектор с SBO-режимом: до N элементов хранятся во встроенном буфере без обращения к куче
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+using SmallVector = Vector<T, Alloc, N>;
+
+// Вектор с буфером, выровненным на Align байт - под выровненные SIMD-загрузки
+template <typename T, size_t Align = 64>
+using AlignedVector = Vector<T, AlignedAllocator<T, Align>>;
+
+// Вектор поверх std::pmr::memory_resource - память берётся у переданного ресурса:
+//     std::pmr::monotonic_buffer_resource arena;
+//     PmrVector<int> v(&arena);
+// Для запросно-скоупной арены и тривиально-разрушимых T смерть вектора не трогает кучу вовсе:
+// destroy_n сворачивается в ничто, а deallocate у монотонного ресурса - пустая операция
 template <typename T>
-bool operator==(const Vector<T>& lhs, const Vector<T>& rhs) {
-    return lhs.Data() == rhs.Data()
-        && lhs.Size() == rhs.Size();
+using PmrVector = Vector<T, std::pmr::polymorphic_allocator<T>>;
+
+// Сравнение по содержимому: векторы равны, если равны их размеры и все элементы.
+// Для тривиально-сравнимых типов оба буфера сравниваются одним memcmp
+template <typename T, typename Alloc, size_t N, typename Growth>
+bool operator==(const Vector<T, Alloc, N, Growth>& lhs, const Vector<T, Alloc, N, Growth>& rhs) {
+    if (lhs.Size() != rhs.Size()) {
+        return false;
+    }
+    if (lhs.begin() == rhs.begin() || lhs.Size() == 0) {
+        return true;                                       // один и тот же буфер либо оба пусты
+    }
+    if constexpr (is_trivially_comparable_v<T>) {
+        return std::memcmp(lhs.begin(), rhs.begin(), lhs.Size() * sizeof(T)) == 0;
+    }
+    else {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
 }
 
-template <typename T>
-bool operator!=(const Vector<T>& lhs, const Vector<T>& rhs) {
-    return lhs.Data() != rhs.Data()
-        && lhs.Size() != rhs.Size();
-}
\ No newline at end of file
+template <typename T, typename Alloc, size_t N, typename Growth>
+bool operator!=(const Vector<T, Alloc, N, Growth>& lhs, const Vector<T, Alloc, N, Growth>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Фасад ограниченной многопоточной дозаписи в вектор: ёмкость резервируется заранее,
+// потоки-писатели захватывают слоты атомарным счётчиком и строят элементы placement new
+// без блокировок и без промежуточных буферов. Пока фасад жив, сам вектор трогать нельзя;
+// после остановки всех писателей Seal() (или деструктор) публикует накопленный размер,
+// и вектор возвращается к обычному однопоточному использованию:
+//     ConcurrentAppender appender(v, 1'000'000);
+//     ... появление TryEmplace из N потоков ...
+//     appender.Seal();
+template <typename T, typename Alloc, size_t InlineCapacity, typename Growth>
+class ConcurrentAppender {
+public:
+
+    using VectorType = Vector<T, Alloc, InlineCapacity, Growth>;
+
+    // Резервирует в target место под capacity элементов и принимает её под запись
+    ConcurrentAppender(VectorType& target, size_t capacity)
+        : target_(target) {
+
+        target_.Detach();                      // живые снимки не должны видеть дозапись
+        target_.Reserve(capacity);
+        claimed_.store(target_.size_, std::memory_order_relaxed);
+    }
+
+    ConcurrentAppender(const ConcurrentAppender&) = delete;
+    ConcurrentAppender& operator=(const ConcurrentAppender&) = delete;
+
+    ~ConcurrentAppender() {
+        Seal();
+    }
+
+    // Захватывает слот и строит в нём элемент; возвращает false, если ёмкость исчерпана.
+    // Можно звать из любого числа потоков одновременно
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+
+        static_assert(std::is_nothrow_constructible_v<T, Args...>,
+            "Concurrent append requires nothrow element construction");
+
+        const size_t slot = claimed_.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= target_.Capacity()) {
+            claimed_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        ::new (static_cast<void*>(target_.data_.GetAddress() + slot)) T(std::forward<Args>(args)...);
+        return true;
+    }
+
+    // Свободная ёмкость, оставшаяся писателям
+    size_t Remaining() const noexcept {
+        const size_t claimed = claimed_.load(std::memory_order_relaxed);
+        return claimed < target_.Capacity() ? target_.Capacity() - claimed : 0;
+    }
+
+    // Публикует дозаписанные элементы в вектор. Вызывается после остановки
+    // всех писателей; повторные вызовы безвредны
+    void Seal() noexcept {
+        if (!sealed_) {
+            target_.size_ = std::min(claimed_.load(std::memory_order_acquire), target_.Capacity());
+            sealed_ = true;
+        }
+    }
+
+private:
+    VectorType& target_;
+    std::atomic<size_t> claimed_{ 0 };
+    bool sealed_ = false;
+};
\ No newline at end of file